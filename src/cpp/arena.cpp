@@ -0,0 +1,94 @@
+/**
+ * @file arena.cpp
+ * @author Wayne Brassem (wbrassem@rogers.com)
+ * @brief Implementation of the arena bump allocator used for the trees built during a scan.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023-2026 Wayne Brassem
+ */
+
+#include <new>
+#include <algorithm>
+#include "common.hpp"
+#include "arena.hpp"
+
+thread_local arena *arena::active = nullptr;
+
+/**
+ * @brief Construct an empty arena
+ * @details No memory is allocated until the first call to allocate().
+ * @param [in] block - The size in bytes of each block taken from the heap.
+ */
+arena::arena( size_t block ) : next( nullptr ), end( nullptr ), block_size( block ), bytes_used( 0 ), bytes_reserved( 0 )
+{
+}
+
+/**
+ * @brief Destroy the arena and free every block
+ */
+arena::~arena()
+{
+    release();
+}
+
+/**
+ * @brief Hand out memory from the current block, starting a new block if it does not fit
+ * @param [in] bytes - The number of bytes needed.
+ * @param [in] align - The alignment needed, which must be a power of 2.
+ * @return void* - Pointer to the memory, which stays valid until the arena is released.  Throws std::bad_alloc on failure.
+ */
+void *arena::allocate( size_t bytes, size_t align )
+{
+    char *p = reinterpret_cast< char * >( ( reinterpret_cast< uintptr_t >( next ) + align - 1 ) & ~uintptr_t( align - 1 ) );
+
+    // Start a new block if the request does not fit in what is left of the current one
+    if ( next == nullptr || p + bytes > end )
+    {
+        size_t size = std::max( block_size, bytes + align );
+        char *block = static_cast< char * >( ::operator new( size ) );
+
+        blocks.push_back( block );
+        bytes_reserved += size;
+
+        end = block + size;
+        p = reinterpret_cast< char * >( ( reinterpret_cast< uintptr_t >( block ) + align - 1 ) & ~uintptr_t( align - 1 ) );
+    }
+
+    next = p + bytes;
+    bytes_used += bytes;
+
+    return p;
+}
+
+/**
+ * @brief Free every block at once
+ * @details Every pointer handed out by the arena becomes invalid.  The destructors of the objects built in the arena are not run,
+ * so this is only safe for types where t_arena_release holds or whose destructors have already been run.
+ */
+void arena::release()
+{
+    for ( char *block : blocks )
+        ::operator delete( block );
+
+    blocks.clear();
+    next = end = nullptr;
+    bytes_used = bytes_reserved = 0;
+}
+
+/**
+ * @brief Make an arena current on this thread
+ * @param [in] pool - The arena to make current or nullptr to have none.
+ */
+arena::scope::scope( arena *pool ) : saved( active )
+{
+    active = pool;
+}
+
+/**
+ * @brief Restore the arena which was current before this scope
+ */
+arena::scope::~scope()
+{
+    active = saved;
+}
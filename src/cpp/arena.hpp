@@ -0,0 +1,105 @@
+/**
+ * @file arena.hpp
+ * @author Wayne Brassem (wbrassem@rogers.com)
+ * @brief The arena class hands out memory for the nodes and keys of the trees built during a scan from large blocks which are
+ * all released at once when the scan is done
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023-2026 Wayne Brassem
+ *
+ */
+
+#pragma once
+#include "common.hpp"
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @brief The arena class is a bump allocator for objects which all live until the end of a scan
+ * @details Long scans such as the convergent pathway counts insert tens of millions of tree nodes and orbit copies and never
+ * remove any of them, so there is no need to free them one at a time.  Memory is handed out in order from blocks of block_size
+ * bytes, and a request larger than a block gets a block of its own.  Nothing is returned to the arena until release() or the
+ * destructor frees every block at once.
+ *
+ * Objects which allocate memory of their own, such as orbit_t when it outgrows its inline storage, take it from the arena made
+ * current by an arena::scope object on the same thread.  This is how a t_btree< K > with an arena copies its keys.
+ */
+class arena
+{
+    public:
+        arena( size_t block = default_block );          // Arena handing out memory from blocks of the given size
+        ~arena();
+
+        arena( const arena & ) = delete;                // An arena owns its blocks so it cannot be copied
+        arena &operator = ( const arena & ) = delete;
+
+        void *allocate( size_t bytes, size_t align = alignof( std::max_align_t ) );
+        void release();                                 // Free every block at once
+
+        inline size_t used() const;
+        inline size_t reserved() const;
+
+        static inline arena *current();
+
+        /**
+         * @brief RAII helper which makes an arena current on this thread for its lifetime
+         */
+        class scope
+        {
+            public:
+                scope( arena *pool );                   // Make pool current, which may be nullptr for none
+                ~scope();                               // Restore the previously current arena
+
+            protected:
+                arena *saved;                           /**< The arena which was current before this scope. */
+        };
+
+        static const size_t default_block = 1 << 20;    /**< Default block size of 1MB. */
+
+    protected:
+        std::vector< char * > blocks;                   /**< Every block allocated so far. */
+        char *next;                                     /**< Next free byte in the current block. */
+        char *end;                                      /**< One past the last byte of the current block. */
+        size_t block_size;                              /**< Size in bytes of a regular block. */
+        size_t bytes_used;                              /**< Total bytes handed out. */
+        size_t bytes_reserved;                          /**< Total bytes held in blocks. */
+
+        static thread_local arena *active;              /**< The current arena of this thread or nullptr. */
+};
+
+/**
+ * @brief Return the number of bytes handed out since the arena was created or last released
+ * @return size_t - Bytes handed out, not counting alignment padding.
+ */
+size_t arena::used() const
+{
+    return bytes_used;
+}
+
+/**
+ * @brief Return the number of bytes held in blocks
+ * @return size_t - Bytes allocated from the heap for the blocks of the arena.
+ */
+size_t arena::reserved() const
+{
+    return bytes_reserved;
+}
+
+/**
+ * @brief Return the current arena of this thread
+ * @return arena* - The arena of the innermost arena::scope on this thread or nullptr if there is none.
+ */
+arena *arena::current()
+{
+    return active;
+}
+
+/**
+ * @brief Whether objects of type K may be released with their arena without running their destructors
+ * @details This holds for types with trivial destructors and for types such as orbit_t whose destructor only returns memory
+ * they took from the current arena.  A t_btree< K > with an arena skips the walk over its nodes when this holds.
+ * @tparam K - The type of the objects allocated from the arena.
+ */
+template < class K >
+struct t_arena_release : std::is_trivially_destructible< K > {};
@@ -0,0 +1,490 @@
+/**
+ * @file batch.cpp
+ * @author Wayne Brassem (wbrassem@rogers.com)
+ * @brief Implementation of the batched stopping time engine with scalar, AVX2 and AVX-512 kernels.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023-2026 Wayne Brassem
+ */
+
+#include <bit>
+#include <limits>
+#include <vector>
+#include "common.hpp"
+#include "batch.hpp"
+
+#if defined( __x86_64__ ) && defined( __GNUC__ )
+#define batch_x86
+#include <immintrin.h>
+#endif
+
+// Largest odd integer whose 3n+1 connection is still representable, matching the overflow point of t_path<int64_t>
+static const int64_t batch_limit = ( std::numeric_limits< int64_t >::max() - 1 ) / 3;
+
+/**
+ * @brief Number of factors of 2 taken on the final downleg of a convergent segment
+ * @details This is the same convergence point found by factor() and setpath_ctz(), the fewest divisions which bring the branch
+ * below the start, limited to the factors of 2 which are available.
+ * @param [in] branch - The even integer following the last 3n+1 connection.
+ * @param [in] start - The starting integer.
+ * @return long - The length of the final downleg.
+ */
+static inline long final_leg( uint64_t branch, uint64_t start )
+{
+    int zeros = std::countr_zero( branch );
+    int leg = std::bit_width( branch ) - std::bit_width( start );
+
+    if ( leg < 1 )
+        leg = 1;
+
+    if ( leg < zeros && ( branch >> leg ) >= start )
+        leg++;
+
+    return ( leg > zeros ) ? zeros : leg;
+}
+
+/**
+ * @brief Record the result for a lane whose orbit has converged or overflowed
+ * @param [in] slot - Index of the starting integer in the run.
+ * @param [in] branch - The even integer following the last 3n+1 connection.
+ * @param [in] start - The starting integer.
+ * @param [in] legs - The number of 3n+1 connections made, or negative if the orbit overflowed.
+ * @param [in] steps - The factors of 2 on all downlegs but the last.
+ * @param [out] lengths - Array of path lengths.
+ * @param [out] factors - Optional array of path factors.
+ */
+static inline void retire( long slot, int64_t branch, int64_t start, int64_t legs, int64_t steps, long *lengths, long *factors )
+{
+    lengths[ slot ] = ( legs < 0 ) ? -1 : legs + 1;
+
+    if ( factors && legs >= 0 )
+        factors[ slot ] = steps + final_leg( branch, start );
+}
+
+/**
+ * @brief Compute the path lengths and factors of a run of consecutive positive starting integers
+ * @details Three quarters of the integers are settled immediately.  Even integers converge on their first factor of 2 with a
+ * path length and factors of 1, and integers of the form 4m+1 converge on their first downleg with a path length and factors of
+ * 2 since ( 3(4m+1)+1 ) / 4 = 3m+1.  Only integers of the form 4m+3 are handed to the SIMD kernels.
+ *
+ * An orbit whose 3n+1 connection would overflow gets a path length of -1 so that the caller can construct the path object
+ * itself and report the overflow in the usual way.
+ * @param [in] first - The first positive starting integer in the run.
+ * @param [in] count - The number of consecutive starting integers.
+ * @param [out] lengths - Array of count path lengths, the same as pathLength() for each integer.
+ * @param [out] factors - Optional array of count path factors, the same as pathFactors() for each integer.
+ */
+void batch::path_lengths( int64_t first, long count, long *lengths, long *factors )
+{
+    for ( long i = 0; i < count; i++ )
+    {
+        int64_t residue = ( first + i ) & 3;
+
+        if ( residue != 3 )
+        {
+            lengths[ i ] = ( residue == 1 ) ? 2 : 1;
+
+            if ( factors )
+                factors[ i ] = lengths[ i ];
+
+            // Even the first connection can overflow
+            if ( residue == 1 && first + i > batch_limit )
+                lengths[ i ] = -1;
+        }
+    }
+
+    switch ( engine() )
+    {
+        case isa::avx512:   avx512_lengths( first, count, lengths, factors );
+                            break;
+        case isa::avx2:     avx2_lengths( first, count, lengths, factors );
+                            break;
+        default:            scalar_lengths( first, count, lengths, factors );
+    }
+}
+
+/**
+ * @brief Select the widest instruction set supported by the processor
+ * @return batch::isa - The instruction set used by path_lengths(), determined on the first call.
+ */
+batch::isa batch::engine()
+{
+#ifdef batch_x86
+    static const isa selected = ( __builtin_cpu_supports( "avx512f" ) && __builtin_cpu_supports( "avx512cd" ) ) ? isa::avx512 :
+                                __builtin_cpu_supports( "avx2" ) ? isa::avx2 : isa::scalar;
+    return selected;
+#else
+    return isa::scalar;
+#endif
+}
+
+/**
+ * @brief Return the name of the instruction set used by path_lengths()
+ * @return const char* - One of "scalar", "AVX2" or "AVX-512".
+ */
+const char *batch::engine_name()
+{
+    switch ( engine() )
+    {
+        case isa::avx512:   return "AVX-512";
+        case isa::avx2:     return "AVX2";
+        default:            return "scalar";
+    }
+}
+
+/**
+ * @brief Scalar kernel which walks the orbits of the integers of the form 4m+3 one at a time
+ * @param [in] first - The first positive starting integer in the run.
+ * @param [in] count - The number of consecutive starting integers.
+ * @param [out] lengths - Array of count path lengths.
+ * @param [out] factors - Optional array of count path factors.
+ */
+void batch::scalar_lengths( int64_t first, long count, long *lengths, long *factors )
+{
+    for ( long i = ( 3 - first ) & 3; i < count; i += 4 )
+    {
+        int64_t start = first + i;
+        int64_t current = start, branch = start;
+        int64_t legs = 0, steps = 0;
+
+        // Take complete downlegs until the odd part of the branch is no longer greater than the start
+        while ( true )
+        {
+            if ( current > batch_limit )
+            {
+                legs = -1;
+                break;
+            }
+
+            branch = 3 * current + 1;
+            legs++;
+
+            int zeros = std::countr_zero( static_cast< uint64_t >( branch ) );
+            current = branch >> zeros;
+
+            if ( current <= start )
+                break;
+
+            steps += zeros;
+        }
+
+        retire( i, branch, start, legs, steps, lengths, factors );
+    }
+}
+
+#ifdef batch_x86
+
+/**
+ * @brief Work queue shared by the lanes of the SIMD kernels
+ * @details The starting integers of the form 4m+3 are queued up front, padded with idle zero starts so that refills near the end
+ * stay in bounds.  Converged lanes are compressed into the output arrays and retired once all the orbits are done.
+ */
+struct batch_queue
+{
+    public:
+        batch_queue( int64_t first, long count, int lanes );
+
+        void retire_all( int64_t first, long *lengths, long *factors ) const;
+
+        std::vector< int64_t > starts;                  /**< Starting integers of the form 4m+3 followed by idle zero starts. */
+        std::vector< int64_t > branch;                  /**< Branch following the last connection of each converged orbit. */
+        std::vector< int64_t > start;                   /**< Starting integer of each converged orbit. */
+        std::vector< int64_t > legs;                    /**< Number of connections of each converged orbit. */
+        std::vector< int64_t > steps;                   /**< Factors of 2 on all but the last downleg of each converged orbit. */
+
+        long taken;                                     /**< Number of starting integers handed to lanes so far. */
+        long retired;                                   /**< Number of converged orbits recorded so far. */
+};
+
+/**
+ * @brief Queue up the starting integers of the form 4m+3 in a run
+ * @param [in] first - The first positive starting integer in the run.
+ * @param [in] count - The number of consecutive starting integers.
+ * @param [in] lanes - The total number of lanes the kernel keeps busy.
+ */
+batch_queue::batch_queue( int64_t first, long count, int lanes )
+{
+    starts.reserve( count / 4 + 2 * lanes );
+
+    for ( long i = ( 3 - first ) & 3; i < count; i += 4 )
+        starts.push_back( first + i );
+
+    long total = starts.size();
+    starts.resize( total + 2 * lanes, 0 );
+
+    branch.resize( total + lanes );
+    start.resize( total + lanes );
+    legs.resize( total + lanes );
+    steps.resize( total + lanes );
+
+    taken = retired = 0;
+}
+
+/**
+ * @brief Record the results of all the converged orbits
+ * @param [in] first - The first positive starting integer in the run.
+ * @param [out] lengths - Array of path lengths.
+ * @param [out] factors - Optional array of path factors.
+ */
+void batch_queue::retire_all( int64_t first, long *lengths, long *factors ) const
+{
+    for ( long r = 0; r < retired; r++ )
+        retire( start[ r ] - first, branch[ r ], start[ r ], legs[ r ], steps[ r ], lengths, factors );
+}
+
+/** @brief The state of four AVX2 lanes */
+struct avx2_lanes
+{
+    __m256i s, c, o, t, going;
+};
+
+/**
+ * @brief Take a complete downleg in four AVX2 lanes, retiring and refilling any which converge
+ * @details AVX2 has neither a 64-bit trailing zero count nor compress and expand instructions.  The trailing zero count comes
+ * from isolating the lowest set bit and reading the exponent of its value as a double, taking the low and high 32 bits
+ * separately so that the conversion is always exact.  Compress and expand are emulated with lane permutations looked up by the
+ * mask of converged lanes.
+ * @param [in,out] v - The state of the lanes.
+ * @param [in,out] q - The work queue.
+ * @param [in] compress - Permutations of 32-bit halves which move the masked lanes to the bottom.
+ * @param [in] expand - Permutations of 32-bit halves which move the bottom lanes into the masked ones.
+ */
+__attribute__(( target( "avx2" ), always_inline ))
+static inline void avx2_pass( avx2_lanes &v, batch_queue &q, const int32_t compress[][ 8 ], const int32_t expand[][ 8 ] )
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi64x( 1 );
+    const __m256i limit = _mm256_set1_epi64x( batch_limit );
+    const __m256i low_half = _mm256_set1_epi64x( 0xFFFFFFFF );
+    const __m256i magic = _mm256_set1_epi64x( 0x4330000000000000 );         // Bit pattern of the double 2^52
+    const __m256i low_bias = _mm256_set1_epi64x( 1023 );                    // Exponent bias of a double
+    const __m256i high_bias = _mm256_set1_epi64x( 1023 - 32 );              // Less 32 for the high half
+
+    __m256i over = _mm256_and_si256( v.going, _mm256_cmpgt_epi64( v.c, limit ) );
+
+    __m256i b = _mm256_add_epi64( _mm256_add_epi64( v.c, v.c ), _mm256_add_epi64( v.c, one ) );
+    __m256i low = _mm256_and_si256( b, _mm256_sub_epi64( zero, b ) );
+
+    // Exponents of the low and high halves of the lowest set bit read from their exact double values
+    __m256i lo = _mm256_or_si256( _mm256_and_si256( low, low_half ), magic );
+    __m256i hi = _mm256_or_si256( _mm256_srli_epi64( low, 32 ), magic );
+
+    lo = _mm256_castpd_si256( _mm256_sub_pd( _mm256_castsi256_pd( lo ), _mm256_castsi256_pd( magic ) ) );
+    hi = _mm256_castpd_si256( _mm256_sub_pd( _mm256_castsi256_pd( hi ), _mm256_castsi256_pd( magic ) ) );
+
+    __m256i zeros = _mm256_blendv_epi8( _mm256_sub_epi64( _mm256_srli_epi64( lo, 52 ), low_bias ),
+                                        _mm256_sub_epi64( _mm256_srli_epi64( hi, 52 ), high_bias ),
+                                        _mm256_cmpeq_epi64( _mm256_and_si256( low, low_half ), zero ) );
+
+    __m256i odd_part = _mm256_srlv_epi64( b, zeros );
+
+    // Converged lanes are no longer greater than their start once the downleg is complete
+    __m256i done = _mm256_or_si256( _mm256_andnot_si256( _mm256_cmpgt_epi64( odd_part, v.s ), v.going ), over );
+
+    // Lanes still going move on to the odd part, finished lanes keep the branch for measuring the final downleg
+    v.o = _mm256_or_si256( _mm256_add_epi64( v.o, one ), over );
+    v.t = _mm256_add_epi64( v.t, _mm256_andnot_si256( done, zeros ) );
+    v.c = _mm256_blendv_epi8( odd_part, b, done );
+
+    int mask = _mm256_movemask_pd( _mm256_castsi256_pd( done ) );
+
+    if ( mask )
+    {
+        // Compress the finished lanes out to the retirement arrays
+        __m256i pack = _mm256_load_si256( ( const __m256i * ) compress[ mask ] );
+
+        _mm256_storeu_si256( ( __m256i * ) ( q.branch.data() + q.retired ), _mm256_permutevar8x32_epi32( v.c, pack ) );
+        _mm256_storeu_si256( ( __m256i * ) ( q.start.data() + q.retired ), _mm256_permutevar8x32_epi32( v.s, pack ) );
+        _mm256_storeu_si256( ( __m256i * ) ( q.legs.data() + q.retired ), _mm256_permutevar8x32_epi32( v.o, pack ) );
+        _mm256_storeu_si256( ( __m256i * ) ( q.steps.data() + q.retired ), _mm256_permutevar8x32_epi32( v.t, pack ) );
+        q.retired += std::popcount( static_cast< unsigned >( mask ) );
+
+        // And expand the next starting integers into them
+        __m256i fresh = _mm256_loadu_si256( ( const __m256i * ) ( q.starts.data() + q.taken ) );
+        fresh = _mm256_permutevar8x32_epi32( fresh, _mm256_load_si256( ( const __m256i * ) expand[ mask ] ) );
+        q.taken += std::popcount( static_cast< unsigned >( mask ) );
+
+        v.s = _mm256_blendv_epi8( v.s, fresh, done );
+        v.c = _mm256_blendv_epi8( v.c, fresh, done );
+        v.o = _mm256_andnot_si256( done, v.o );
+        v.t = _mm256_andnot_si256( done, v.t );
+
+        // Idle lanes have a start of zero and never converge
+        v.going = _mm256_cmpgt_epi64( v.s, zero );
+    }
+}
+
+/**
+ * @brief AVX2 kernel which walks the orbits of eight integers of the form 4m+3 side by side
+ * @details The lanes are split into two independent sets of four so that the long dependency chain of one pass overlaps with
+ * the other.
+ * @param [in] first - The first positive starting integer in the run.
+ * @param [in] count - The number of consecutive starting integers.
+ * @param [out] lengths - Array of count path lengths.
+ * @param [out] factors - Optional array of count path factors.
+ */
+__attribute__(( target( "avx2" ) ))
+void batch::avx2_lengths( int64_t first, long count, long *lengths, long *factors )
+{
+    const int lanes = 4;
+
+    // Permutations of 32-bit halves which compress the masked lanes to the bottom or expand the bottom lanes into the masked ones
+    alignas( 32 ) static int32_t compress[ 1 << lanes ][ 2 * lanes ], expand[ 1 << lanes ][ 2 * lanes ];
+    static bool permutations = false;
+
+    if ( !permutations )
+    {
+        for ( int mask = 0; mask < ( 1 << lanes ); mask++ )
+        {
+            for ( int l = 0, in = 0, out = 0; l < lanes; l++ )
+            {
+                bool masked = ( mask >> l ) & 1;
+
+                expand[ mask ][ 2 * l ] = 2 * ( masked ? in : l );
+                expand[ mask ][ 2 * l + 1 ] = 2 * ( masked ? in++ : l ) + 1;
+
+                compress[ mask ][ 2 * l ] = compress[ mask ][ 2 * l + 1 ] = 0;
+
+                if ( masked )
+                {
+                    compress[ mask ][ 2 * out ] = 2 * l;
+                    compress[ mask ][ 2 * out++ + 1 ] = 2 * l + 1;
+                }
+            }
+        }
+
+        permutations = true;
+    }
+
+    batch_queue q( first, count, 2 * lanes );
+
+    avx2_lanes v[ 2 ];
+
+    for ( avx2_lanes &w : v )
+    {
+        w.s = w.c = _mm256_loadu_si256( ( const __m256i * ) ( q.starts.data() + q.taken ) );
+        w.o = w.t = _mm256_setzero_si256();
+        w.going = _mm256_cmpgt_epi64( w.s, w.o );
+        q.taken += lanes;
+    }
+
+    while ( !_mm256_testz_si256( _mm256_or_si256( v[ 0 ].going, v[ 1 ].going ), _mm256_or_si256( v[ 0 ].going, v[ 1 ].going ) ) )
+    {
+        avx2_pass( v[ 0 ], q, compress, expand );
+        avx2_pass( v[ 1 ], q, compress, expand );
+    }
+
+    q.retire_all( first, lengths, factors );
+}
+
+/** @brief The state of eight AVX-512 lanes */
+struct avx512_lanes
+{
+    __m512i s, c, o, t;
+    __mmask8 going;
+};
+
+/**
+ * @brief Take a complete downleg in eight AVX-512 lanes, retiring and refilling any which converge
+ * @details With AVX-512CD the trailing zero count of every lane comes from a leading zero count of its lowest set bit.  Mask
+ * registers select the converged and overflowed lanes, which are compressed out to the work queue and refilled by expanding the
+ * next starting integers into them.
+ * @param [in,out] v - The state of the lanes.
+ * @param [in,out] q - The work queue.
+ */
+__attribute__(( target( "avx512f,avx512cd" ), always_inline ))
+static inline void avx512_pass( avx512_lanes &v, batch_queue &q )
+{
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi64( 1 );
+    const __m512i top = _mm512_set1_epi64( 63 );
+    const __m512i limit = _mm512_set1_epi64( batch_limit );
+    const __m512i flag = _mm512_set1_epi64( -1 );
+
+    __mmask8 over = _mm512_mask_cmpgt_epi64_mask( v.going, v.c, limit );
+
+    __m512i b = _mm512_add_epi64( _mm512_add_epi64( v.c, v.c ), _mm512_add_epi64( v.c, one ) );
+    __m512i low = _mm512_and_si512( b, _mm512_sub_epi64( zero, b ) );
+    __m512i zeros = _mm512_sub_epi64( top, _mm512_lzcnt_epi64( low ) );
+    __m512i odd_part = _mm512_srlv_epi64( b, zeros );
+
+    __mmask8 done = _mm512_mask_cmple_epi64_mask( v.going, odd_part, v.s ) | over;
+
+    // Lanes still going move on to the odd part, finished lanes keep the branch for measuring the final downleg
+    v.o = _mm512_mask_mov_epi64( _mm512_add_epi64( v.o, one ), over, flag );
+    v.t = _mm512_mask_add_epi64( v.t, v.going & ~done, v.t, zeros );
+    v.c = _mm512_mask_mov_epi64( odd_part, done, b );
+
+    if ( done )
+    {
+        // Compress the finished lanes out to the retirement arrays
+        _mm512_storeu_si512( q.branch.data() + q.retired, _mm512_maskz_compress_epi64( done, v.c ) );
+        _mm512_storeu_si512( q.start.data() + q.retired, _mm512_maskz_compress_epi64( done, v.s ) );
+        _mm512_storeu_si512( q.legs.data() + q.retired, _mm512_maskz_compress_epi64( done, v.o ) );
+        _mm512_storeu_si512( q.steps.data() + q.retired, _mm512_maskz_compress_epi64( done, v.t ) );
+        q.retired += std::popcount( static_cast< unsigned >( done ) );
+
+        // And expand the next starting integers into them
+        v.s = _mm512_mask_expand_epi64( v.s, done, _mm512_loadu_si512( q.starts.data() + q.taken ) );
+        q.taken += std::popcount( static_cast< unsigned >( done ) );
+
+        v.c = _mm512_mask_mov_epi64( v.c, done, v.s );
+        v.o = _mm512_mask_mov_epi64( v.o, done, zero );
+        v.t = _mm512_mask_mov_epi64( v.t, done, zero );
+
+        // Idle lanes have a start of zero and are never stepped
+        v.going = _mm512_cmpneq_epi64_mask( v.s, zero );
+    }
+}
+
+/**
+ * @brief AVX-512 kernel which walks the orbits of sixteen integers of the form 4m+3 side by side
+ * @details The lanes are split into two independent sets of eight so that the dependency chain of one pass overlaps with the
+ * other.
+ * @param [in] first - The first positive starting integer in the run.
+ * @param [in] count - The number of consecutive starting integers.
+ * @param [out] lengths - Array of count path lengths.
+ * @param [out] factors - Optional array of count path factors.
+ */
+__attribute__(( target( "avx512f,avx512cd" ) ))
+void batch::avx512_lengths( int64_t first, long count, long *lengths, long *factors )
+{
+    const int lanes = 8;
+
+    batch_queue q( first, count, 2 * lanes );
+
+    avx512_lanes v[ 2 ];
+
+    for ( avx512_lanes &w : v )
+    {
+        w.s = w.c = _mm512_loadu_si512( q.starts.data() + q.taken );
+        w.o = w.t = _mm512_setzero_si512();
+        w.going = _mm512_cmpneq_epi64_mask( w.s, w.o );
+        q.taken += lanes;
+    }
+
+    while ( v[ 0 ].going | v[ 1 ].going )
+    {
+        avx512_pass( v[ 0 ], q );
+        avx512_pass( v[ 1 ], q );
+    }
+
+    q.retire_all( first, lengths, factors );
+}
+
+#else
+
+// Without x86 SIMD support the vector kernels are never selected, but they still need definitions
+
+void batch::avx2_lengths( int64_t first, long count, long *lengths, long *factors )
+{
+    scalar_lengths( first, count, lengths, factors );
+}
+
+void batch::avx512_lengths( int64_t first, long count, long *lengths, long *factors )
+{
+    scalar_lengths( first, count, lengths, factors );
+}
+
+#endif
@@ -0,0 +1,46 @@
+/**
+ * @file batch.hpp
+ * @author Wayne Brassem (wbrassem@rogers.com)
+ * @brief Batched stopping time engine which computes path lengths and factors for runs of consecutive positive integers
+ * several at a time using SIMD registers when the processor supports them
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023-2026 Wayne Brassem
+ *
+ */
+
+#pragma once
+#include "common.hpp"
+
+/**
+ * @brief The batch class computes the convergent path length and factors of consecutive positive 64-bit starting integers
+ * @details Histogram oriented menu options such as the convergent legs and equivalence class counts only consume the number of
+ * downlegs of each orbit, so there is no need to build a path object for every integer in the range.  Three quarters of the
+ * integers are settled directly from their residue modulo 4, and the rest are queued up for a kernel which takes one complete
+ * downleg per pass using a trailing zero count.  The SIMD kernels walk 8 (AVX2) or 16 (AVX-512) orbits side by side in two
+ * independent groups.  As each orbit drops below its starting integer its lane is retired and refilled with the next queued
+ * starting integer, so the lanes stay busy until the run is exhausted.
+ *
+ * The downlegs are exactly those made by t_path<int64_t> under the standard 3n+1 connection, so the number of downlegs plus one
+ * is pathLength() and their factors of 2 add up to pathFactors().
+ *
+ * The instruction set is chosen once at run time, falling back to a scalar loop on processors without AVX2 or on other
+ * architectures.
+ */
+class batch
+{
+    public:
+        /** @brief Instruction set used by the engine */
+        enum class isa : uint8_t { scalar, avx2, avx512 };
+
+        static void path_lengths( int64_t first, long count, long *lengths, long *factors = nullptr );
+
+        static isa engine();                            // Instruction set selected for this processor
+        static const char *engine_name();               // Human readable name of the instruction set
+
+    protected:
+        static void scalar_lengths( int64_t first, long count, long *lengths, long *factors );
+        static void avx2_lengths( int64_t first, long count, long *lengths, long *factors );
+        static void avx512_lengths( int64_t first, long count, long *lengths, long *factors );
+};
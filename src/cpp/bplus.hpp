@@ -0,0 +1,697 @@
+/**
+ * @file bplus.hpp
+ * @author Wayne Brassem (wbrassem@rogers.com)
+ * @brief The t_bplus< K > template is a B+-tree with the same interface as t_btree< K >.  Its wide nodes hold their keys side
+ * by side, so a search touches a few blocks of memory rather than one node for every comparison.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023-2026 Wayne Brassem
+ *
+ */
+
+#pragma once
+#include "common.hpp"
+#include "btree.hpp"
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @brief The templated t_bplus< K, B > class counts keys of type K in a B+-tree
+ * @details Every node holds up to B keys in one array.  The leaves also hold the count of each key in a parallel array and are
+ * chained in key order.  The inner nodes hold copies of the first key of each subtree but the first, which guide a search down
+ * to the right leaf.  Nodes live in two pools, one for leaves and one for inner nodes, and refer to one another by 32-bit
+ * indices rather than pointers.  The pools grow a block at a time and never move the nodes already in them.  A tree of n keys
+ * is only about log( n ) / log( B / 2 ) levels deep, and each level is searched by bisection within a single node.
+ *
+ * A full leaf or inner node is split in half as a key is inserted, so every node but the root is at least half full.  A sorted
+ * list of keys is loaded by bulk_load() instead, which fills every leaf and builds the inner levels from the bottom up in linear
+ * time.  Merging two trees uses the same path, so it is linear as well.
+ *
+ * Compared with t_btree< K > this saves the two child pointers, the height and the heap block of every key, which is most of the
+ * memory of a tree of short strings.
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ */
+template < class K, int B = 32 >
+class t_bplus
+{
+    public:
+        static_assert( B >= 4, "t_bplus requires at least 4 keys per node" );
+
+        t_bplus();
+
+        void insert( const K &key );
+        void insert( const K &key, ulong count );       // Insert or increment by a number of instances at once
+        void insert( K &&key );                         // Insert by moving the key into a leaf
+        void insert( K &&key, ulong count );
+        template < class... A > void emplace( A&&... args );    // Insert a key built from constructor arguments
+        long search( const K &key ) const;
+
+        template < class I > void bulk_load( I first, I last );  // Replace the tree with a sorted range of key and count pairs
+
+        // Merge another tree into this one, summing the counts of keys found in both
+        void merge( const t_bplus< K, B > &tree );
+        void merge( t_bplus< K, B > &&tree );           // Merge by moving the keys of the other tree
+
+        // const Iterators take an optional callable which is passed the key and count, and stops early by returning false
+        template < class F = std::nullptr_t > inline long constForwardIterator( F &&func = nullptr ) const;
+        template < class F = std::nullptr_t > inline long constReverseIterator( F &&func = nullptr ) const;
+
+        long nodes() const;                             // Return the number of distinct keys, as t_btree< K > does
+        void destroy_tree();                            // Remove every key and free memory
+
+    protected:
+        /** @brief A leaf holding up to B keys in order with their counts */
+        struct leaf_node
+        {
+            K           keys[ B ];                      /**< The keys in ascending order. */
+            ulong       counts[ B ];                    /**< The count (frequency) of each key. */
+            uint32_t    prev;                           /**< Index of the previous leaf in key order or none. */
+            uint32_t    next;                           /**< Index of the next leaf in key order or none. */
+            int         size;                           /**< The number of keys in use. */
+        };
+
+        /** @brief An inner node whose child i holds the keys from keys[ i - 1 ] up to but not including keys[ i ] */
+        struct inner_node
+        {
+            K           keys[ B ];                      /**< The separating keys in ascending order. */
+            uint32_t    children[ B + 1 ];              /**< Indices of the children, which are leaves on the level above them. */
+            int         size;                           /**< The number of keys in use, which is one less than the children. */
+        };
+
+        template < class Q > void insert_key( Q &&key, ulong count );
+        void push_up( const uint32_t *path, const int *slot, K &&separator, uint32_t right );
+        void insert_child( uint32_t index, int slot, K &&separator, uint32_t child );
+        uint32_t new_leaf();
+        uint32_t new_inner();
+        void export_keys( std::vector< std::pair< K, ulong > > &list, bool move );
+        template < class F > long traverse( F &func, bool forward ) const;
+
+        static const uint32_t none = UINT32_MAX;        /**< Index which refers to no node. */
+        static const int max_height = 32;               /**< Bound on the levels of a tree of 32-bit node indices. */
+
+        std::deque< leaf_node > leaves;                 /**< Every leaf, the first of which is always the first in key order. */
+        std::deque< inner_node > inners;                /**< Every inner node. */
+        uint32_t root;                                  /**< Index of the root, which is a leaf when the height is 1. */
+        uint32_t last_leaf;                             /**< Index of the last leaf in key order. */
+        int height;                                     /**< The number of levels, or 0 for an empty tree. */
+        ulong key_count;                                /**< The number of distinct keys. */
+};
+
+// Template definitions
+
+// t_bplus< K, B > public member functions
+
+/**
+ * @brief Default constructor for an empty t_bplus< K, B > object
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ */
+template < class K, int B >
+t_bplus< K, B >::t_bplus() : root( none ), last_leaf( none ), height( 0 ), key_count( 0 )
+{
+}
+
+/**
+ * @brief Public insert function to count one instance of a key
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @param [in] key - The key of type K to add or count (frequency) to increment if found.
+ */
+template < class K, int B >
+void t_bplus< K, B >::insert( const K &key )
+{
+    insert_key( key, 1 );
+}
+
+/**
+ * @brief Public insert function to count a number of instances of a key at once
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @param [in] key - The key of type K to add or count (frequency) to increment if found.
+ * @param [in] count - The number of instances of the key to add.
+ */
+template < class K, int B >
+void t_bplus< K, B >::insert( const K &key, ulong count )
+{
+    insert_key( key, count );
+}
+
+/**
+ * @brief Public insert function to count one instance of a key, moving the key in if it is new
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @param [in] key - The key of type K to add or count (frequency) to increment if found.
+ */
+template < class K, int B >
+void t_bplus< K, B >::insert( K &&key )
+{
+    insert_key( std::move( key ), 1 );
+}
+
+/**
+ * @brief Public insert function to count a number of instances of a key at once, moving the key in if it is new
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @param [in] key - The key of type K to add or count (frequency) to increment if found.
+ * @param [in] count - The number of instances of the key to add.
+ */
+template < class K, int B >
+void t_bplus< K, B >::insert( K &&key, ulong count )
+{
+    insert_key( std::move( key ), count );
+}
+
+/**
+ * @brief Public insert function to count a key given the arguments of a K constructor
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @tparam A - The types of the constructor arguments.
+ * @param [in] args - The arguments passed on to the K constructor.
+ */
+template < class K, int B >
+template < class... A >
+void t_bplus< K, B >::emplace( A&&... args )
+{
+    insert_key( K( std::forward< A >( args )... ), 1 );
+}
+
+/**
+ * @brief Public search function which looks for a key
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @param [in] key - The key of type K to search for.
+ * @return long - Return the count (frequency) of the key, or 0 if it is not found.
+ */
+template < class K, int B >
+long t_bplus< K, B >::search( const K &key ) const
+{
+    if ( height == 0 )
+        return 0;
+
+    uint32_t n = root;
+
+    // Follow the separating keys down to the leaf which would hold the key
+    for ( int level = 1; level < height; ++level )
+    {
+        const inner_node &inner = inners[ n ];
+        n = inner.children[ std::upper_bound( inner.keys, inner.keys + inner.size, key ) - inner.keys ];
+    }
+
+    const leaf_node &leaf = leaves[ n ];
+    const K *found = std::lower_bound( leaf.keys, leaf.keys + leaf.size, key );
+
+    return ( found != leaf.keys + leaf.size && *found == key ) ? leaf.counts[ found - leaf.keys ] : 0;
+}
+
+/**
+ * @brief Replace the contents of the tree with a sorted range of key and count pairs
+ * @details Every leaf is filled in turn, and each inner level is then built over the level below with the children shared out
+ * evenly between as few nodes as will hold them, so the tree is built in linear time with the least memory.  Pairs of move
+ * iterators move the keys into the tree.
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @tparam I - An input iterator over objects with a key in first and a count in second, such as std::pair< K, ulong >.
+ * @param [in] first - The first pair, whose keys must be in strictly ascending order.
+ * @param [in] last - One past the last pair.
+ */
+template < class K, int B >
+template < class I >
+void t_bplus< K, B >::bulk_load( I first, I last )
+{
+    destroy_tree();
+
+    // Fill the leaves in key order
+    for ( ; first != last; ++first )
+    {
+        auto &&pair = *first;
+
+        if ( pair.second == 0 )
+            continue;
+
+        if ( leaves.empty() || leaves.back().size == B )
+        {
+            uint32_t index = new_leaf();
+
+            if ( index > 0 )
+            {
+                leaves[ index - 1 ].next = index;
+                leaves[ index ].prev = index - 1;
+            }
+        }
+
+        leaf_node &leaf = leaves.back();
+
+        leaf.keys[ leaf.size ] = std::forward< decltype( pair ) >( pair ).first;
+        leaf.counts[ leaf.size++ ] = pair.second;
+        key_count++;
+    }
+
+    if ( leaves.empty() )
+        return;
+
+    // Each level is a list of nodes and the first key of each of their subtrees, which is always in a leaf
+    std::vector< std::pair< uint32_t, const K * > > level, above;
+
+    for ( uint32_t index = 0; index < leaves.size(); ++index )
+        level.push_back( { index, &leaves[ index ].keys[ 0 ] } );
+
+    last_leaf = leaves.size() - 1;
+    height = 1;
+
+    // Build inner levels until a single node is left as the root
+    while ( level.size() > 1 )
+    {
+        size_t parents = ( level.size() + B ) / ( B + 1 );
+        size_t next = 0;
+
+        above.clear();
+
+        for ( size_t p = 0; p < parents; ++p )
+        {
+            // Share the children out evenly so that no inner node is left with a single child
+            size_t share = level.size() / parents + ( p < level.size() % parents ? 1 : 0 );
+            uint32_t index = new_inner();
+            inner_node &inner = inners[ index ];
+
+            for ( size_t c = 0; c < share; ++c, ++next )
+            {
+                inner.children[ c ] = level[ next ].first;
+
+                if ( c > 0 )
+                    inner.keys[ inner.size++ ] = *level[ next ].second;
+            }
+
+            above.push_back( { index, level[ next - share ].second } );
+        }
+
+        level.swap( above );
+        height++;
+    }
+
+    root = level[ 0 ].first;
+}
+
+/**
+ * @brief Merge a copy of another tree into this one, summing the counts of the keys found in both
+ * @details The keys of both trees are listed in order, the lists are merged in one linear pass and the tree is loaded again from
+ * the merged list, so the merge costs O(n + m).  The other tree is left unchanged.
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @param [in] tree - Constant reference to the t_bplus< K, B > to merge into this one.
+ */
+template < class K, int B >
+void t_bplus< K, B >::merge( const t_bplus< K, B > &tree )
+{
+    t_bplus< K, B > copy;
+
+    // Only the keys of the other tree are copied, and merging a tree with itself doubles every count
+    tree.constForwardIterator( [ &copy ]( const K &key, long count ) { copy.insert( key, count ); } );
+
+    merge( std::move( copy ) );
+}
+
+/**
+ * @brief Merge another tree into this one by moving its keys, summing the counts of the keys found in both
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @param [in] tree - The t_bplus< K, B > to take the keys from, which is left empty.
+ */
+template < class K, int B >
+void t_bplus< K, B >::merge( t_bplus< K, B > &&tree )
+{
+    if ( this == &tree || tree.key_count == 0 )
+        return;
+
+    std::vector< std::pair< K, ulong > > ours, theirs, merged;
+
+    export_keys( ours, true );
+    tree.export_keys( theirs, true );
+    tree.destroy_tree();
+
+    merged.reserve( ours.size() + theirs.size() );
+
+    // Merge the sorted lists, adding the counts of the keys found in both
+    auto a = ours.begin(), b = theirs.begin();
+
+    while ( a != ours.end() || b != theirs.end() )
+    {
+        if ( b == theirs.end() || ( a != ours.end() && a->first < b->first ) )
+            merged.push_back( std::move( *a++ ) );
+
+        else if ( a == ours.end() || !( a->first == b->first ) )
+            merged.push_back( std::move( *b++ ) );
+
+        else
+        {
+            a->second += ( b++ )->second;
+            merged.push_back( std::move( *a++ ) );
+        }
+    }
+
+    bulk_load( std::make_move_iterator( merged.begin() ), std::make_move_iterator( merged.end() ) );
+}
+
+/**
+ * @brief Iterates over the keys in forward sort order
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @tparam F - The visitor type, which is deduced.
+ * @param [in] func - Optional visitor accepting a reference to the const key of type K and the count, which may be a function
+ * pointer or any callable.  A visitor returning bool ends the iteration by returning false.
+ * @return long - Returns the sum of counts of all keys visited.
+ * @see t_visit
+ */
+template < class K, int B >
+template < class F >
+long t_bplus< K, B >::constForwardIterator( F &&func ) const
+{
+    return traverse( func, true );
+}
+
+/**
+ * @brief Iterates over the keys in reverse sort order
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @tparam F - The visitor type, which is deduced.
+ * @param [in] func - Optional visitor accepting a reference to the const key of type K and the count, which may be a function
+ * pointer or any callable.  A visitor returning bool ends the iteration by returning false.
+ * @return long - Returns the sum of counts of all keys visited.
+ * @see t_visit
+ */
+template < class K, int B >
+template < class F >
+long t_bplus< K, B >::constReverseIterator( F &&func ) const
+{
+    return traverse( func, false );
+}
+
+/**
+ * @brief Function which returns the number of distinct keys, which is the number of nodes a t_btree< K > would have
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @return long - Return the number of distinct keys.
+ */
+template < class K, int B >
+long t_bplus< K, B >::nodes() const
+{
+    return key_count;
+}
+
+/**
+ * @brief Removes every key and frees the memory of the nodes
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ */
+template < class K, int B >
+void t_bplus< K, B >::destroy_tree()
+{
+    std::deque< leaf_node >().swap( leaves );
+    std::deque< inner_node >().swap( inners );
+
+    root = none;
+    last_leaf = none;
+    height = 0;
+    key_count = 0;
+}
+
+
+// t_bplus< K, B > protected member functions
+
+/**
+ * @brief Count a key, inserting it into its leaf if it has not been seen before
+ * @details The path down from the root is remembered so that a full leaf can be split and its new sibling linked into the level
+ * above, which may split in turn all the way up to the root.
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @tparam Q - The key type, which is either a const reference or an rvalue reference to K.
+ * @param [in] key - The key of type K to add or count (frequency) to increment if found.
+ * @param [in] count - The number of instances of the key to add.
+ */
+template < class K, int B >
+template < class Q >
+void t_bplus< K, B >::insert_key( Q &&key, ulong count )
+{
+    // Nothing to add
+    if ( count == 0 )
+        return;
+
+    // The first key starts a tree with a single leaf as its root
+    if ( height == 0 )
+    {
+        root = last_leaf = new_leaf();
+        height = 1;
+    }
+
+    uint32_t path[ max_height ];
+    int slot[ max_height ];
+    uint32_t n = root;
+
+    // Follow the separating keys down to the leaf, remembering the inner nodes and the child taken at each
+    for ( int level = 0; level + 1 < height; ++level )
+    {
+        const inner_node &inner = inners[ n ];
+
+        path[ level ] = n;
+        slot[ level ] = std::upper_bound( inner.keys, inner.keys + inner.size, key ) - inner.keys;
+        n = inner.children[ slot[ level ] ];
+    }
+
+    int i = std::lower_bound( leaves[ n ].keys, leaves[ n ].keys + leaves[ n ].size, key ) - leaves[ n ].keys;
+
+    // If the key is found increment the frequency
+    if ( i < leaves[ n ].size && leaves[ n ].keys[ i ] == key )
+    {
+        leaves[ n ].counts[ i ] += count;
+        return;
+    }
+
+    key_count++;
+
+    // A full leaf moves its upper half to a new leaf which follows it in key order
+    uint32_t right = none;
+
+    if ( leaves[ n ].size == B )
+    {
+        right = new_leaf();
+
+        leaf_node &full = leaves[ n ], &sibling = leaves[ right ];
+        int half = B / 2;
+
+        std::move( full.keys + half, full.keys + B, sibling.keys );
+        std::copy( full.counts + half, full.counts + B, sibling.counts );
+        sibling.size = B - half;
+        full.size = half;
+
+        sibling.prev = n;
+        sibling.next = full.next;
+
+        if ( full.next != none )
+            leaves[ full.next ].prev = right;
+        else
+            last_leaf = right;
+
+        full.next = right;
+
+        if ( i > half )
+        {
+            n = right;
+            i -= half;
+        }
+    }
+
+    // Open a gap for the key and its count
+    leaf_node &leaf = leaves[ n ];
+
+    std::move_backward( leaf.keys + i, leaf.keys + leaf.size, leaf.keys + leaf.size + 1 );
+    std::copy_backward( leaf.counts + i, leaf.counts + leaf.size, leaf.counts + leaf.size + 1 );
+
+    leaf.keys[ i ] = std::forward< Q >( key );
+    leaf.counts[ i ] = count;
+    leaf.size++;
+
+    // The first key of a new leaf separates it from the leaf before it
+    if ( right != none )
+        push_up( path, slot, K( leaves[ right ].keys[ 0 ] ), right );
+}
+
+/**
+ * @brief Link a new node into the level above after a split, splitting the inner nodes on the way up as they fill
+ * @details A full inner node keeps its lower half, moves its upper half to a new inner node and passes its middle key up to
+ * separate the two.  When the root itself splits a new root is made above it and the tree grows by one level.
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @param [in] path - The inner nodes on the way down from the root to the node which split.
+ * @param [in] slot - The child taken at each inner node on the way down.
+ * @param [in] separator - The first key of the subtree of the new node.
+ * @param [in] right - Index of the new node, which follows the node that split.
+ */
+template < class K, int B >
+void t_bplus< K, B >::push_up( const uint32_t *path, const int *slot, K &&separator, uint32_t right )
+{
+    for ( int level = height - 2; level >= 0; --level )
+    {
+        uint32_t n = path[ level ];
+        int i = slot[ level ];
+
+        // An inner node with room simply takes the new child
+        if ( inners[ n ].size < B )
+        {
+            insert_child( n, i, std::move( separator ), right );
+            return;
+        }
+
+        uint32_t sibling = new_inner();
+        inner_node &full = inners[ n ], &split = inners[ sibling ];
+        int half = B / 2;
+
+        K middle = std::move( full.keys[ half ] );
+
+        std::move( full.keys + half + 1, full.keys + B, split.keys );
+        std::copy( full.children + half + 1, full.children + B + 1, split.children );
+        split.size = B - half - 1;
+        full.size = half;
+
+        // The new child goes to whichever half now holds the child it follows
+        if ( i <= half )
+            insert_child( n, i, std::move( separator ), right );
+        else
+            insert_child( sibling, i - half - 1, std::move( separator ), right );
+
+        separator = std::move( middle );
+        right = sibling;
+    }
+
+    // The root split, so a new root is made above the two halves
+    uint32_t top = new_inner();
+    inner_node &inner = inners[ top ];
+
+    inner.keys[ 0 ] = std::move( separator );
+    inner.children[ 0 ] = root;
+    inner.children[ 1 ] = right;
+    inner.size = 1;
+
+    root = top;
+    height++;
+}
+
+/**
+ * @brief Insert a child into an inner node with room for it
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @param [in] index - Index of the inner node.
+ * @param [in] slot - The child which the new child follows.
+ * @param [in] separator - The first key of the subtree of the new child.
+ * @param [in] child - Index of the new child.
+ */
+template < class K, int B >
+void t_bplus< K, B >::insert_child( uint32_t index, int slot, K &&separator, uint32_t child )
+{
+    inner_node &inner = inners[ index ];
+
+    std::move_backward( inner.keys + slot, inner.keys + inner.size, inner.keys + inner.size + 1 );
+    std::copy_backward( inner.children + slot + 1, inner.children + inner.size + 1, inner.children + inner.size + 2 );
+
+    inner.keys[ slot ] = std::move( separator );
+    inner.children[ slot + 1 ] = child;
+    inner.size++;
+}
+
+/**
+ * @brief Add an empty leaf
+ * @details Nodes are referred to by 32-bit index rather than by pointer, which halves the size of each child link.
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @return uint32_t - Index of the new leaf, which is linked to no other leaf.
+ */
+template < class K, int B >
+uint32_t t_bplus< K, B >::new_leaf()
+{
+    if ( leaves.size() >= none )
+        throw std::length_error( "B+-tree exceeds the range of 32-bit node indices." );
+
+    leaves.emplace_back();
+    leaves.back().prev = none;
+    leaves.back().next = none;
+    leaves.back().size = 0;
+
+    return leaves.size() - 1;
+}
+
+/**
+ * @brief Add an empty inner node
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @return uint32_t - Index of the new inner node.
+ */
+template < class K, int B >
+uint32_t t_bplus< K, B >::new_inner()
+{
+    if ( inners.size() >= none )
+        throw std::length_error( "B+-tree exceeds the range of 32-bit node indices." );
+
+    inners.emplace_back();
+    inners.back().size = 0;
+
+    return inners.size() - 1;
+}
+
+/**
+ * @brief List every key and its count in forward sort order
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @param [out] list - The list the keys and counts are appended to.
+ * @param [in] move - Whether the keys are moved out of the tree, which must then be destroyed or loaded again.
+ */
+template < class K, int B >
+void t_bplus< K, B >::export_keys( std::vector< std::pair< K, ulong > > &list, bool move )
+{
+    list.reserve( list.size() + key_count );
+
+    for ( uint32_t n = leaves.empty() ? none : 0; n != none; n = leaves[ n ].next )
+    {
+        leaf_node &leaf = leaves[ n ];
+
+        for ( int i = 0; i < leaf.size; ++i )
+            list.emplace_back( move ? std::move( leaf.keys[ i ] ) : leaf.keys[ i ], leaf.counts[ i ] );
+    }
+}
+
+/**
+ * @brief The traverse function walks the chain of leaves in forward or reverse order
+ * @tparam K - Ordinal type K - must be default constructible and support < and == comparison operations.
+ * @tparam B - The largest number of keys in a node.
+ * @tparam F - The visitor type.
+ * @param [in] func - Optional visitor which can be used for custom key processing during traversal
+ * @param [in] forward - Boolean value indicating if forward (true) or reverse (false) traversal is required
+ * @return long - Returns the total number of counts from all keys visited
+ */
+template < class K, int B >
+template < class F >
+long t_bplus< K, B >::traverse( F &func, bool forward ) const
+{
+    long sum = 0;
+    uint32_t n = forward ? ( leaves.empty() ? none : 0 ) : last_leaf;
+
+    for ( ; n != none; n = forward ? leaves[ n ].next : leaves[ n ].prev )
+    {
+        const leaf_node &leaf = leaves[ n ];
+
+        for ( int k = 0; k < leaf.size; ++k )
+        {
+            int i = forward ? k : leaf.size - 1 - k;
+
+            // Add the key count to the sum and call the visitor, which may end the traversal
+            sum += leaf.counts[ i ];
+
+            if ( !t_visit( func, leaf.keys[ i ], leaf.counts[ i ] ) )
+                return sum;
+        }
+    }
+
+    return sum;
+}
@@ -13,7 +13,7 @@
 
 /**
  * @brief Construct a new node object for use in a binary tree
- * @details Set all initial values to 0 and pointers to subtended nodes to nullptr.
+ * @details Set all initial values to 0 and pointers to subtended nodes to nullptr, which makes the node a leaf of height 1.
  */
 node::node()
 {
@@ -21,6 +21,7 @@ node::node()
     count       = 0;
     left        = nullptr;
     right       = nullptr;
+    height      = 1;
 }
 
 
@@ -42,9 +43,23 @@ btree::btree()
  */
 btree::btree( const btree &tree )
 {
+    zeroize();
     operator=( tree );
 }
 
+/**
+ * @brief Move constructor for creating a new binary tree object from another
+ * @details Takes over the nodes of the other tree, which is left empty.
+ * @param [in] tree - The btree to take the nodes from.
+ */
+btree::btree( btree &&tree ) noexcept
+{
+    root = tree.root;
+    node_count = tree.node_count;
+
+    tree.zeroize();
+}
+
 /**
  * @brief Destructor for the binary tree object
  * @details Recursively destroys subtrees and frees memory using the destroy_tree() function.
@@ -61,19 +76,8 @@ btree::~btree()
  */
 void btree::insert( const long key )
 {
-    // If the tree exists (root is not null) then find where to insert the node
-    if ( root != nullptr )
-        insert( key, root );
- 
-    // Otherwise it's the start of a new tree and set the root node counter to 1
-    else
-    {
-        root = new node;
-        root->key_value = key;
-
-        root->count = 1;
-        node_count = 1;
-    } 
+    // Find where to insert the node, which may change the root as the tree is rebalanced
+    root = insert( key, root );
 }
 
 /**
@@ -95,6 +99,62 @@ long btree::search( long key ) const
         return 0;
 }
 
+/**
+ * @brief Merge a copy of another tree into this one, summing the counts of the keys found in both
+ * @details Both trees are flattened into sorted lists of nodes, the lists are merged in one linear pass and a perfectly balanced
+ * tree is built from the result, so the merge costs O(n + m).  The other tree is left unchanged.
+ * @param [in] tree - Constant reference to the btree to merge into this one.
+ */
+void btree::merge( const btree &tree )
+{
+    btree copy( tree );
+
+    merge( std::move( copy ) );
+}
+
+/**
+ * @brief Merge another tree into this one by taking over its nodes, summing the counts of the keys found in both
+ * @details The nodes of the other tree are linked into this one, and the nodes of the keys found in both are freed once their
+ * counts are added.  The other tree is left empty.
+ * @param [in] tree - The btree to take the nodes from.
+ */
+void btree::merge( btree &&tree )
+{
+    if ( this == &tree || tree.root == nullptr )
+        return;
+
+    std::vector< node * > ours, theirs, merged;
+
+    flatten( ours );
+    tree.flatten( theirs );
+    merged.reserve( ours.size() + theirs.size() );
+
+    // Merge the sorted lists, taking over the nodes which are only in the other tree
+    auto a = ours.begin(), b = theirs.begin();
+
+    while ( a != ours.end() || b != theirs.end() )
+    {
+        if ( b == theirs.end() || ( a != ours.end() && ( *a )->key_value < ( *b )->key_value ) )
+            merged.push_back( *a++ );
+
+        else if ( a == ours.end() || ( *a )->key_value != ( *b )->key_value )
+            merged.push_back( *b++ );
+
+        else
+        {
+            ( *a )->count += ( *b )->count;
+            delete *b++;
+            merged.push_back( *a++ );
+        }
+    }
+
+    root = build( merged.data(), merged.size() );
+    node_count = merged.size();
+
+    // Every node of the other tree has been linked in or freed
+    tree.zeroize();
+}
+
 /**
  * @brief Iterates over the binary tree in forward sort order
  * @param [in] func - Optional function pointer accepting long node key
@@ -146,6 +206,29 @@ btree& btree::operator=( const btree &tree )
     return *this;
 }
 
+/**
+ * @brief Moves one tree to another
+ * @details Destroys any existing tree and takes over the nodes of the other tree, which is left empty.
+ * @param [in] tree - The btree to take the nodes from.
+ * @return btree& - Returns a reference to this tree.
+ */
+btree& btree::operator=( btree &&tree ) noexcept
+{
+    // Protect against self-assignment
+    if (this == &tree)
+        return *this;
+
+    // First clear any existing state
+    destroy_tree();
+
+    root = tree.root;
+    node_count = tree.node_count;
+
+    tree.zeroize();
+
+    return *this;
+}
+
 /**
  * @brief Function which returns the total number of nodes in the btree
  * @return long - Return the number of nodes in the binary tree
@@ -172,51 +255,40 @@ void btree::destroy_tree()
  * @details The protected insert begins with the root node which is passed in as the starting point by the public
  * insert function.  The function first tries to locate the node and inserts it (in order) if it is not found.  If the
  * node is found then the count (frequency) of the node is incremented.  The function is recursive until it is known
- * that the node does not exist in the tree in which case it is added with an initial count of 1.
+ * that the node does not exist in the tree in which case it is added with an initial count of 1.  Each subtree on the way
+ * back up is rebalanced.
  * @param [in] key - The key to insert if not found, or the count to increment if found
- * @param [in] leaf - The current node being searched.
+ * @param [in] leaf - The current node being searched, or nullptr where the new node belongs.
+ * @return node* - The root of the subtree after the insert.
  */
-void btree::insert( long key, node *leaf )
+node *btree::insert( long key, node *leaf )
 {
-    // If the key is found increment the frequency
-    if ( key == leaf->key_value )
-        leaf->count++;
-
-    // If the key is greater than the current one
-    else if ( key > leaf->key_value )
+    // Insert the new key here and initialize the reference count to 1
+    if ( leaf == nullptr )
     {
-        // If the right path is not null continue search there
-        if ( leaf->right != nullptr )
-            insert( key, leaf->right );
+        leaf = new node;
+        leaf->key_value = key;
 
-        // Otherwise insert the new key here and initialize the reference count to 1
-        else
-        {
-            leaf->right = new node;
-            leaf->right->key_value = key;
+        leaf->count = 1;
+        node_count++;
 
-            leaf->right->count = 1;
-            node_count++;
-        }
+        return leaf;
     }
 
-    // Otherwise if the key is less than the current one
-    else
+    // If the key is found increment the frequency, which leaves the shape of the tree alone
+    if ( key == leaf->key_value )
     {
-        // If the left path is not null continue search there
-        if ( leaf->left != nullptr )
-            insert( key, leaf->left );
+        leaf->count++;
+        return leaf;
+    }
 
-        // Otherwise insert the new key here and initialize the reference count to 1
-        else
-        {
-            leaf->left=new node;
-            leaf->left->key_value = key;
+    // If the key is greater than the current one continue in the right subtree, otherwise in the left one
+    if ( key > leaf->key_value )
+        leaf->right = insert( key, leaf->right );
+    else
+        leaf->left = insert( key, leaf->left );
 
-            leaf->left->count = 1;
-            node_count++;
-        }  
-    }
+    return balance( leaf );
 }
 
 /**
@@ -306,6 +378,7 @@ node* btree::duplicate( node *nptr )
     node *node_copy = new node;
     node_copy->count = nptr->count;
     node_copy->key_value = nptr->key_value;
+    node_copy->height = nptr->height;
 
     // Now copy the left and right subtrees
     node_copy->left = duplicate( nptr->left );
@@ -314,6 +387,135 @@ node* btree::duplicate( node *nptr )
     return node_copy;
 }
 
+/**
+ * @brief Return the height of a subtree
+ * @param [in] leaf - The root of the subtree or nullptr.
+ * @return int - The height, which is 0 for an empty subtree.
+ */
+int btree::height( const node *leaf )
+{
+    return leaf ? leaf->height : 0;
+}
+
+/**
+ * @brief Rotate a subtree to the left so that its right child becomes its root
+ * @param [in] leaf - The root of the subtree, which must have a right child.
+ * @return node* - The new root of the subtree.
+ */
+node *btree::rotate_left( node *leaf )
+{
+    node *pivot = leaf->right;
+
+    leaf->right = pivot->left;
+    pivot->left = leaf;
+
+    // The old root is now below the pivot so its height is settled first
+    leaf->height = 1 + std::max( height( leaf->left ), height( leaf->right ) );
+    pivot->height = 1 + std::max( height( pivot->left ), height( pivot->right ) );
+
+    return pivot;
+}
+
+/**
+ * @brief Rotate a subtree to the right so that its left child becomes its root
+ * @param [in] leaf - The root of the subtree, which must have a left child.
+ * @return node* - The new root of the subtree.
+ */
+node *btree::rotate_right( node *leaf )
+{
+    node *pivot = leaf->left;
+
+    leaf->left = pivot->right;
+    pivot->right = leaf;
+
+    // The old root is now below the pivot so its height is settled first
+    leaf->height = 1 + std::max( height( leaf->left ), height( leaf->right ) );
+    pivot->height = 1 + std::max( height( pivot->left ), height( pivot->right ) );
+
+    return pivot;
+}
+
+/**
+ * @brief Restore the AVL balance of a subtree after one of its children grew by one level
+ * @details A subtree whose children differ in height by two is rotated toward the shorter side, with a double rotation when the
+ * taller child leans the other way.  Otherwise only the height is updated.
+ * @param [in] leaf - The root of the subtree, whose children are balanced.
+ * @return node* - The root of the balanced subtree.
+ */
+node *btree::balance( node *leaf )
+{
+    int skew = height( leaf->left ) - height( leaf->right );
+
+    if ( skew > 1 )
+    {
+        if ( height( leaf->left->left ) < height( leaf->left->right ) )
+            leaf->left = rotate_left( leaf->left );
+
+        return rotate_right( leaf );
+    }
+
+    if ( skew < -1 )
+    {
+        if ( height( leaf->right->right ) < height( leaf->right->left ) )
+            leaf->right = rotate_right( leaf->right );
+
+        return rotate_left( leaf );
+    }
+
+    leaf->height = 1 + std::max( height( leaf->left ), height( leaf->right ) );
+
+    return leaf;
+}
+
+/**
+ * @brief List the nodes of the tree in forward sort order
+ * @param [out] list - The list the nodes are appended to.
+ */
+void btree::flatten( std::vector< node * > &list ) const
+{
+    std::vector< node * > stack;
+    node *leaf = root;
+
+    list.reserve( list.size() + node_count );
+
+    while ( leaf != nullptr || !stack.empty() )
+    {
+        while ( leaf != nullptr )
+        {
+            stack.push_back( leaf );
+            leaf = leaf->left;
+        }
+
+        leaf = stack.back();
+        stack.pop_back();
+
+        list.push_back( leaf );
+        leaf = leaf->right;
+    }
+}
+
+/**
+ * @brief Build a balanced tree from a sorted list of nodes
+ * @details The middle node becomes the root and each half is built the same way, which is a valid AVL tree.
+ * @param [in] first - The first node of the list.
+ * @param [in] count - The number of nodes in the list.
+ * @return node* - The root of the tree, or nullptr if the list is empty.
+ */
+node *btree::build( node **first, size_t count )
+{
+    if ( count == 0 )
+        return nullptr;
+
+    size_t middle = count / 2;
+    node *leaf = first[ middle ];
+
+    leaf->left = build( first, middle );
+    leaf->right = build( first + middle + 1, count - middle - 1 );
+    leaf->height = 1 + std::max( height( leaf->left ), height( leaf->right ) );
+
+    return leaf;
+}
+
 /**
  * @brief Destroys current node and subtending nodes
  * @details This function can be used to destroy any subtree of a binary tree.  If called using the root node as
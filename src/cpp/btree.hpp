@@ -2,7 +2,8 @@
  * @file btree.hpp
  * @author Wayne Brassem (wbrassem@rogers.com)
  * @brief As the name implies the btree and node classes and templates implement a binary tree.  This structure is used
- * to efficiently search and store Collatz related objects like convergent pathways.
+ * to efficiently search and store Collatz related objects like convergent pathways.  The trees are kept height balanced as
+ * AVL trees so that keys arriving in sorted order, which is how most scans produce them, can not degrade the tree into a list.
  * @version 1.1
  * @date 2025-12-19
  * 
@@ -11,6 +12,46 @@
 
 #pragma once
 #include "common.hpp"
+#include "arena.hpp"
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+#include <bit>
+
+/**
+ * @brief Call a traversal visitor for one key and report whether the traversal should go on
+ * @details The visitor may be nullptr, a function pointer or any callable such as a lambda, which the compiler can then inline
+ * into the traversal loop.  A visitor which returns bool stops the traversal as soon as it returns false, and any other visitor
+ * sees every key.
+ * @tparam F - The visitor type.
+ * @tparam K - The key type.
+ * @param [in] func - The visitor.
+ * @param [in] key - The key being visited.
+ * @param [in] count - The count (frequency) of the key.
+ * @return true  - Returns true  if the traversal should continue.
+ * @return false - Returns false if the visitor asked to stop.
+ */
+template < class F, class K >
+inline bool t_visit( F &func, const K &key, long count )
+{
+    if constexpr ( std::is_null_pointer< F >::value )
+        return true;
+    else
+    {
+        // A function pointer may still be null at run time
+        if constexpr ( std::is_pointer< F >::value )
+            if ( func == nullptr )
+                return true;
+
+        if constexpr ( std::is_same< std::invoke_result_t< F &, const K &, long >, bool >::value )
+            return func( key, count );
+        else
+        {
+            func( key, count );
+            return true;
+        }
+    }
+}
 
 /**
  * @brief The node struct definition for use in btree implementation
@@ -25,36 +66,46 @@ struct node
         ulong count;                                    /**< Value used to provide ordinal instance counts. */
         node *left;                                     /**< Pointer to the left subtree. */
         node *right;                                    /**< Pointer to the right subtree. */
+        int height;                                     /**< Height of the subtree rooted at this node, which is 1 for a leaf. */
 };
 
 /**
  * @brief The btree class definition for use in storing convergent paths.
- * @details This is a generic binary tree implementation, but it's primary aim is for storing convergent Collatz paths.
+ * @details This is a generic binary tree implementation, but it's primary aim is for storing convergent Collatz paths.  The tree
+ * is an AVL tree, so the heights of the two subtrees of every node differ by at most one and the depth of a tree of n nodes is
+ * less than 1.45 log2( n ).  Inserts and searches are O(log n) whatever the order of the keys, and the recursion in traverse(),
+ * duplicate() and destroy_tree() stays shallow.
  */
 class btree
 {
     public:
         btree();                                        // Default constructor
         btree( const btree &tree );                     // Copy constructor
+        btree( btree &&tree ) noexcept;                 // Move constructor
         ~btree();                                       // Destructor
  
         // Basic node insertion and search member functions
         void insert( const long key );                  // Public insert function
         long search( long key ) const;                  // Returns the count for a given node key
 
+        // Merge another tree into this one, summing the counts of keys found in both
+        void merge( const btree &tree );
+        void merge( btree &&tree );                     // Merge by taking over the nodes of the other tree
+
         // const Iterators take an optional function pointer which passed in the key and count values as long
         long constForwardIterator( void (*func)( long key, long count ) = nullptr ) const;
         long constReverseIterator( void (*func)( long key, long count ) = nullptr ) const;
 
         // Assignment operator
         btree& operator=( const btree &tree );          // Assignment operator
+        btree& operator=( btree &&tree ) noexcept;      // Move assignment operator
 
         long nodes() const;                             // Return number of nodes in btree
         void destroy_tree();                            // Destroys tree and free memory
 
     protected:
-        // Insert a node or increment existing one
-        void insert( long key, node *leaf );
+        // Insert a node or increment existing one, returning the root of the rebalanced subtree
+        node *insert( long key, node *leaf );
 
         // Search for a node and return pointer, or nullptr if not found
         node *search( long key, node *leaf ) const;
@@ -63,6 +114,16 @@ class btree
         long traverse( node *leaf, long &sum, void (*func)( long key, long count ), bool forward ) const;
 
         node *duplicate( node *nptr );                  // Clone a tree and subtree given a starting point
+
+        // Linear time merges flatten both trees into sorted lists of nodes and build a balanced tree from the merged list
+        void flatten( std::vector< node * > &list ) const;
+        static node *build( node **first, size_t count );
+
+        // AVL balancing of a subtree whose children are already balanced
+        static int height( const node *leaf );
+        static node *rotate_left( node *leaf );
+        static node *rotate_right( node *leaf );
+        static node *balance( node *leaf );
  
         void destroy_tree( node *leaf );                // Destroy the tree and subtree given a starting point
         void zeroize();
@@ -88,11 +149,12 @@ struct t_node
         ulong   count;                                  /**< Value used to provide ordinal instance counts. */
         t_node  *left;                                  /**< Pointer to the left subtree. */
         t_node  *right;                                 /**< Pointer to the right subtree. */
+        int     height;                                 /**< Height of the subtree rooted at this node, which is 1 for a leaf. */
 };
 
 /**
  * @brief Construct a new templated t_node< K > object for use in a t_btree< K > binary tree
- * @details Set all initial values to 0 and pointers to subtended nodes to nullptr.
+ * @details Set all initial values to 0 and pointers to subtended nodes to nullptr, which makes the node a leaf of height 1.
  * @tparam K - Ordinal type K - must support <, > and == comparison operations.
  * The key_value member is default initialized.
  */
@@ -102,12 +164,15 @@ t_node< K >::t_node()
     count       = 0;
     left        = nullptr;
     right       = nullptr;
+    height      = 1;
 }
 
 
 /**
  * @brief The templated t_btree< K > class definition for use in storing convergent paths of element type K.
- * @details This is a generic binary tree implementation, but it's primary aim is for storing convergent Collatz paths.
+ * @details This is a generic binary tree implementation, but it's primary aim is for storing convergent Collatz paths.  Like
+ * btree it is an AVL tree, so strings such as the flows of consecutive integers, which arrive in nearly sorted order, are
+ * inserted in O(log n) rather than growing a single chain of nodes.
  * @tparam K - Ordinal type K - must support <, > and == comparison operations.
  */
 template < class K > 
@@ -116,38 +181,66 @@ class t_btree
     public:
         t_btree();
         t_btree( const t_btree< K > &tree );            // Copy constructor
+        t_btree( t_btree< K > &&tree ) noexcept;        // Move constructor
         ~t_btree();
+
+        void use_arena( arena *pool );                  // Allocate nodes and keys from an arena while the tree is empty
  
         void insert( const K &key );
+        void insert( const K &key, ulong count );       // Insert or increment by a number of instances at once
+        void insert( K &&key );                         // Insert by moving the key into a new node
+        void insert( K &&key, ulong count );
+        template < class... A > void emplace( A&&... args );    // Insert a key built from constructor arguments
         long search( const K &key ) const;
 
-        // const Iterators take an optional function pointer which return copies of the key and count values
-        inline long constForwardIterator( void (*func)( const K &key, long count ) = nullptr ) const;
-        inline long constReverseIterator( void (*func)( const K &key, long count ) = nullptr ) const;
+        // Merge another tree into this one, summing the counts of keys found in both
+        void merge( const t_btree< K > &tree );
+        void merge( t_btree< K > &&tree );              // Merge by taking over the nodes of the other tree
+
+        // const Iterators take an optional callable which is passed the key and count, and stops early by returning false
+        template < class F = std::nullptr_t > inline long constForwardIterator( F &&func = nullptr ) const;
+        template < class F = std::nullptr_t > inline long constReverseIterator( F &&func = nullptr ) const;
 
         // Block default shallow copy assignment operator
         t_btree< K >& operator=( const t_btree< K > &tree );
+        t_btree< K >& operator=( t_btree< K > &&tree ) noexcept;
 
         long nodes() const;                             // Return number of nodes in btree
         void destroy_tree();                            // Destroys tree and free memory
 
     protected:
-        // Insert a node or increment existing one
-        void insert( const K &key, t_node< K > *leaf);
+        // Insert a node or increment existing one, returning the root of the rebalanced subtree
+        template < class Q > t_node< K > *insert( Q &&key, ulong count, t_node< K > *leaf );
 
         // Search for a node and return pointer, or nullptr if not found
         t_node< K > *search( const K &key, t_node< K > *leaf) const;
 
-        // The traverse function iterates the tree in forward or reverse order and optionally calls a function per node
-        long traverse( t_node< K > *leaf, long &sum, void (*func)( const K &key, long count ), bool forward ) const;
+        // The traverse function iterates the tree in forward or reverse order and optionally calls a visitor per node
+        template < class F > long traverse( F &func, bool forward ) const;
 
         t_node< K > *duplicate( t_node< K > *nptr );    // Clone a tree and subtree given a starting point
+        template < class Q > t_node< K > *new_node( Q &&key, ulong count );      // Allocate a node from the arena or the heap
+        void free_node( t_node< K > *leaf );            // Free a node to the heap, or just destroy it in an arena
+
+        // Linear time merges flatten both trees into sorted lists of nodes and build a balanced tree from the merged list
+        bool merge_by_insert( ulong count ) const;
+        void flatten( std::vector< t_node< K > * > &list ) const;
+        static t_node< K > *build( t_node< K > **first, size_t count );
+
+        // AVL balancing of a subtree whose children are already balanced
+        static int height( const t_node< K > *leaf );
+        static t_node< K > *rotate_left( t_node< K > *leaf );
+        static t_node< K > *rotate_right( t_node< K > *leaf );
+        static t_node< K > *balance( t_node< K > *leaf );
 
         void destroy_tree( t_node< K > *leaf );         // Destroy the tree and subtree given a starting point
         void zeroize();
 
+        static const int max_height = 96;               /**< Bound on the height of an AVL tree of up to 2^64 nodes. */
+
         t_node< K > *root;                              /**< Pointer to the root node or nullptr if empty tree. */
         ulong node_count;                               /**< Counter which keeps the total number of nodes in tree. */
+        arena *pool;                                    /**< Arena the nodes are allocated from or nullptr for the heap. */
 };
 
 // Template definitions
@@ -166,6 +259,7 @@ class t_btree
 template < class K >
 t_btree< K >::t_btree()
 {
+    pool = nullptr;
     zeroize();
 }
 
@@ -178,9 +272,28 @@ t_btree< K >::t_btree()
 template < class K >
 t_btree< K >::t_btree( const t_btree< K > &tree)
 {
+    pool = nullptr;
+    zeroize();
+
     operator=( tree );
 }
 
+/**
+ * @brief Move constructor for creating a new binary t_btree< K > object from another
+ * @details Takes over the nodes and arena of the other tree, which is left empty.
+ * @tparam K - Ordinal type K - must support <, > and == comparison operations.
+ * @param [in] tree - The t_btree< K > to take the nodes from.
+ */
+template < class K >
+t_btree< K >::t_btree( t_btree< K > &&tree ) noexcept
+{
+    root = tree.root;
+    node_count = tree.node_count;
+    pool = tree.pool;
+
+    tree.zeroize();
+}
+
 /**
  * @brief Destructor for the binary t_btree< K > object
  * @details Recursively destroys subtrees and frees memory using the destroy_tree() function.
@@ -192,6 +305,23 @@ t_btree< K >::~t_btree()
     destroy_tree();
 }
 
+/**
+ * @brief Allocate the nodes and keys of the tree from an arena
+ * @details Every node is then placed in the arena, and the key is copied into it with the arena current so that any memory
+ * the key needs comes from the arena as well.  Destroying the tree does not return anything to the arena, and when
+ * t_arena_release< K > holds it does not even walk the nodes, so the memory of the whole tree is reclaimed at once when the arena
+ * is released.  The arena must outlive the tree.  This has no effect unless the tree is empty.
+ * @tparam K - Ordinal type K - must support <, > and == comparison operations.
+ * @param [in] pool - The arena to allocate from or nullptr for the heap.
+ * @see arena
+ */
+template < class K >
+void t_btree< K >::use_arena( arena *pool )
+{
+    if ( root == nullptr )
+        this->pool = pool;
+}
+
 /**
  * @brief Public insert function to add a t_node< K > given a key
  * @details Function first searches for the existence of a given node and inserts if not found, or increments count if found.
@@ -201,19 +331,72 @@ t_btree< K >::~t_btree()
 template < class K >
 void t_btree< K >::insert( const K &key )
 {
-    // If the tree exists (root is not null) then find where to insert the node
-    if ( root != nullptr )
-        insert( key, root );
+    insert( key, 1 );
+}
 
-    // Otherwise it's the start of a new tree and set the root node counter to 1
-    else
-    {
-        root = new t_node< K >;
-        root->key_value = key;
+/**
+ * @brief Public insert function to add a t_node< K > given a key and the number of instances of that key
+ * @details Equivalent to calling insert( key ) count times, which lets the scan drivers add the contribution of a whole residue
+ * class of integers sharing the same key in one step.
+ * @tparam K - Ordinal type K - must support <, > and == comparison operations.
+ * @param [in] key - The node key of type K to add or count (frequency) to increment if found.
+ * @param [in] count - The number of instances of the key to add.
+ */
+template < class K >
+void t_btree< K >::insert( const K &key, ulong count )
+{
+    // Nothing to add
+    if ( count == 0 )
+        return;
 
-        root->count = 1;
-        node_count = 1;
-    } 
+    // Find where to insert the node, which may change the root as the tree is rebalanced
+    root = insert( key, count, root );
+}
+
+/**
+ * @brief Public insert function to add a t_node< K > by moving a key into it
+ * @details The same as insert( key ) except that a key which is not already in the tree is moved into the new node instead of
+ * being copied.
+ * @tparam K - Ordinal type K - must support <, > and == comparison operations.
+ * @param [in] key - The node key of type K to add or count (frequency) to increment if found.
+ */
+template < class K >
+void t_btree< K >::insert( K &&key )
+{
+    insert( std::move( key ), 1 );
+}
+
+/**
+ * @brief Public insert function to add a t_node< K > by moving a key into it given the number of instances of that key
+ * @details The same as insert( key, count ) except that a key which is not already in the tree is moved into the new node
+ * instead of being copied.
+ * @tparam K - Ordinal type K - must support <, > and == comparison operations.
+ * @param [in] key - The node key of type K to add or count (frequency) to increment if found.
+ * @param [in] count - The number of instances of the key to add.
+ */
+template < class K >
+void t_btree< K >::insert( K &&key, ulong count )
+{
+    // Nothing to add
+    if ( count == 0 )
+        return;
+
+    // Find where to insert the node, which may change the root as the tree is rebalanced
+    root = insert( std::move( key ), count, root );
+}
+
+/**
+ * @brief Public insert function to add a t_node< K > given the arguments of a K constructor
+ * @details The key is built from the arguments and then moved into a new node if it is not already in the tree.
+ * @tparam K - Ordinal type K - must support <, > and == comparison operations.
+ * @tparam A - The types of the constructor arguments.
+ * @param [in] args - The arguments passed on to the K constructor.
+ */
+template < class K >
+template < class... A >
+void t_btree< K >::emplace( A&&... args )
+{
+    insert( K( std::forward< A >( args )... ) );
 }
 
 /**
@@ -237,34 +420,151 @@ long t_btree< K >::search( const K &key ) const
         return 0;
 }
 
+/**
+ * @brief Merge a copy of another tree into this one, summing the counts of the keys found in both
+ * @details This is how partial histograms built by separate workers are combined.  When the other tree is small compared to this
+ * one its keys are simply inserted, which costs O(m log n).  Otherwise both trees are flattened into sorted lists of nodes, the
+ * lists are merged in one linear pass and a perfectly balanced tree is built from the result, which costs O(n + m) however the
+ * keys of the two trees interleave.  The keys of the other tree are copied and it is left unchanged.
+ * @tparam K - Ordinal type K - must support <, > and == comparison operations.
+ * @param [in] tree - Constant reference to the t_btree< K > to merge into this one.
+ */
+template < class K >
+void t_btree< K >::merge( const t_btree< K > &tree )
+{
+    // Merging a tree with itself doubles every count, which needs a copy to merge from
+    if ( this == &tree )
+    {
+        t_btree< K > copy( tree );
+        merge( std::move( copy ) );
+        return;
+    }
+
+    if ( tree.root == nullptr )
+        return;
+
+    // A small tree is cheaper to insert one key at a time
+    if ( merge_by_insert( tree.node_count ) )
+    {
+        tree.constForwardIterator( [ this ]( const K &key, long count ) { insert( key, count ); } );
+        return;
+    }
+
+    std::vector< t_node< K > * > ours, theirs, merged;
+
+    flatten( ours );
+    tree.flatten( theirs );
+    merged.reserve( ours.size() + theirs.size() );
+
+    // Merge the sorted lists, copying the keys which are only in the other tree into new nodes
+    auto a = ours.begin(), b = theirs.begin();
+
+    while ( a != ours.end() || b != theirs.end() )
+    {
+        if ( b == theirs.end() || ( a != ours.end() && ( *a )->key_value < ( *b )->key_value ) )
+            merged.push_back( *a++ );
+
+        else if ( a == ours.end() || !( ( *a )->key_value == ( *b )->key_value ) )
+        {
+            merged.push_back( new_node( ( *b )->key_value, ( *b )->count ) );
+            b++;
+        }
+
+        else
+        {
+            ( *a )->count += ( *b++ )->count;
+            merged.push_back( *a++ );
+        }
+    }
+
+    root = build( merged.data(), merged.size() );
+    node_count = merged.size();
+}
+
+/**
+ * @brief Merge another tree into this one by taking over its nodes, summing the counts of the keys found in both
+ * @details The same as merge( const t_btree< K > & ) except that no key is copied.  The nodes of the other tree are linked into
+ * this one, and the nodes of the keys found in both are freed once their counts are added.  Nodes can only change hands when
+ * both trees allocate from the same arena, or both from the heap, so otherwise the keys are copied.  The other tree is left empty.
+ * @tparam K - Ordinal type K - must support <, > and == comparison operations.
+ * @param [in] tree - The t_btree< K > to take the nodes from.
+ */
+template < class K >
+void t_btree< K >::merge( t_btree< K > &&tree )
+{
+    if ( this == &tree || tree.root == nullptr )
+        return;
+
+    // Nodes from another arena or the heap can not be linked in, and a small tree is cheaper to insert one key at a time
+    if ( pool != tree.pool || merge_by_insert( tree.node_count ) )
+    {
+        merge( static_cast< const t_btree< K > & >( tree ) );
+        tree.destroy_tree();
+        return;
+    }
+
+    std::vector< t_node< K > * > ours, theirs, merged;
+
+    flatten( ours );
+    tree.flatten( theirs );
+    merged.reserve( ours.size() + theirs.size() );
+
+    // Merge the sorted lists, taking over the nodes which are only in the other tree
+    auto a = ours.begin(), b = theirs.begin();
+
+    while ( a != ours.end() || b != theirs.end() )
+    {
+        if ( b == theirs.end() || ( a != ours.end() && ( *a )->key_value < ( *b )->key_value ) )
+            merged.push_back( *a++ );
+
+        else if ( a == ours.end() || !( ( *a )->key_value == ( *b )->key_value ) )
+            merged.push_back( *b++ );
+
+        else
+        {
+            ( *a )->count += ( *b )->count;
+            free_node( *b++ );
+            merged.push_back( *a++ );
+        }
+    }
+
+    root = build( merged.data(), merged.size() );
+    node_count = merged.size();
+
+    // Every node of the other tree has been linked in or freed
+    tree.zeroize();
+}
+
 /**
  * @brief Iterates over the binary tree in forward sort order
  * @tparam K - Ordinal type K - must support <, > and == comparison operations.
- * @param [in] func - Optional templated function pointer accepting reference to const node key of type K
- * and count values which can be used for node handling during forward iteration.
- * @return long - Returns the sum of counts of all nodes in the binary tree.
+ * @tparam F - The visitor type, which is deduced.
+ * @param [in] func - Optional visitor accepting a reference to the const node key of type K and the count, which may be a function
+ * pointer or any callable.  A visitor returning bool ends the iteration by returning false.
+ * @return long - Returns the sum of counts of all nodes visited, which is every node unless the visitor stopped early.
+ * @see t_visit
  */
 template < class K >
-long t_btree< K >::constForwardIterator( void (*func)( const K &key, long count )  ) const
+template < class F >
+long t_btree< K >::constForwardIterator( F &&func ) const
 {
-    // Call the protected traverse function by passing the root node
-    long sum = 0;
-    return traverse( root, sum, func, true );
+    return traverse( func, true );
 }
 
 /**
  * @brief Iterates over the binary tree in reverse sort order
  * @tparam K - Ordinal type K - must support <, > and == comparison operations.
- * @param [in] func - Optional templated function pointer accepting reference to const node key of type K
- * and count values which can be used for node handling during reverse iteration.
- * @return long - Returns the sum of counts of all nodes in the binary tree.
+ * @tparam F - The visitor type, which is deduced.
+ * @param [in] func - Optional visitor accepting a reference to the const node key of type K and the count, which may be a function
+ * pointer or any callable.  A visitor returning bool ends the iteration by returning false.
+ * @return long - Returns the sum of counts of all nodes visited, which is every node unless the visitor stopped early.
+ * @see t_visit
  */
 template < class K >
-long t_btree< K >::constReverseIterator( void (*func)( const K &key, long count )  ) const
+template < class F >
+long t_btree< K >::constReverseIterator( F &&func ) const
 {
-    // Call the protected traverse function by passing the root node
-    long sum = 0;
-    return traverse( root, sum, func, false );
+    return traverse( func, false );
 }
 
 /**
@@ -294,6 +594,32 @@ t_btree< K >& t_btree< K >::operator=( const t_btree< K > &tree )
     return *this;
 }
 
+/**
+ * @brief Moves one tree to another
+ * @details Destroys any existing t_btree< K > and takes over the nodes and arena of the other tree, which is left empty.
+ * @tparam K - Ordinal type K - must support <, > and == comparison operations.
+ * @param [in] tree - The t_btree< K > to take the nodes from.
+ * @return btree& - Returns a reference to this tree.
+ */
+template < class K >
+t_btree< K >& t_btree< K >::operator=( t_btree< K > &&tree ) noexcept
+{
+    // Protect against self-assignment
+    if (this == &tree)
+        return *this;
+
+    // First clear any existing state
+    destroy_tree();
+
+    root = tree.root;
+    node_count = tree.node_count;
+    pool = tree.pool;
+
+    tree.zeroize();
+
+    return *this;
+}
+
 /**
  * @brief Fnction which returns the total number of nodes in the t_btree< K >
  * @tparam K - Ordinal type K - must support <, > and == comparison operations.
@@ -312,7 +638,10 @@ long t_btree< K >::nodes() const
 template < class K >
 void t_btree< K >::destroy_tree()
 {
-    destroy_tree(root);
+    // Nodes in an arena whose keys need no destructor are simply left for the arena to release
+    if ( !pool || !t_arena_release< K >::value )
+        destroy_tree(root);
+
     zeroize();
 }
 
@@ -324,53 +653,40 @@ void t_btree< K >::destroy_tree()
  * @details The protected insert begins with the root t_node< K > which is passed in as the starting point by the public
  * insert function.  The function first tries to locate the t_node< K > and inserts it (in order) if it is not found.  If the
  * node is found then the count (frequency) of the t_node< K > is incremented.  The function is recursive until it is known
- * that the node does not exist in the tree in which case it is added with an initial count of 1.
+ * that the node does not exist in the tree in which case it is added with the given initial count.  Each subtree on the way
+ * back up is rebalanced, which takes at most two rotations for the whole insert.
  * @tparam K - Ordinal type K - must support <, > and == comparison operations.
- * @param [in] key - The const key of type K to insert if not found, or the count to increment if found
- * @param [in] leaf - The current t_node< K > being searched.
+ * @tparam Q - The key type, which is either a const reference or an rvalue reference to K.
+ * @param [in] key - The key of type K to insert if not found, or the count to increment if found
+ * @param [in] count - The number of instances of the key to add.
+ * @param [in] leaf - The current t_node< K > being searched, or nullptr where the new node belongs.
+ * @return t_node< K >* - The root of the subtree after the insert.
  */
 template < class K >
-void t_btree< K >::insert( const K &key, t_node< K > *leaf )
+template < class Q >
+t_node< K > *t_btree< K >::insert( Q &&key, ulong count, t_node< K > *leaf )
 {
-    // If the key is found increment the frequency
-    if ( key == leaf->key_value )
-        leaf->count++;
-
-    // If the key is greater than the current one
-    else if ( key > leaf->key_value )
+    // Insert the new key here and initialize the reference count
+    if ( leaf == nullptr )
     {
-        // If the right path is not null continue search there
-        if ( leaf->right != nullptr )
-            insert( key, leaf->right );
-
-        // Otherwise insert the new key here and initialize the reference count to 1
-        else
-        {
-            leaf->right = new t_node< K >;
-            leaf->right->key_value = key;
-
-            leaf->right->count = 1;
-            node_count++;                        // Increment the node count
-        }
+        node_count++;                            // Increment the node count
+        return new_node( std::forward< Q >( key ), count );
     }
 
-    // Otherwise if the key is less than the current one
-    else
+    // If the key is found increment the frequency, which leaves the shape of the tree alone
+    if ( key == leaf->key_value )
     {
-        // If the left path is not null continue search there
-        if ( leaf->left != nullptr )
-            insert( key, leaf->left );
+        leaf->count += count;
+        return leaf;
+    }
 
-        // Otherwise insert the new key here and initialize the reference count to 1
-        else
-        {
-            leaf->left = new t_node< K >;
-            leaf->left->key_value = key;
+    // If the key is greater than the current one continue in the right subtree, otherwise in the left one
+    if ( key > leaf->key_value )
+        leaf->right = insert( std::forward< Q >( key ), count, leaf->right );
+    else
+        leaf->left = insert( std::forward< Q >( key ), count, leaf->left );
 
-            leaf->left->count = 1;
-            node_count++;                        // Increment the node count
-        }  
-    }
+    return balance( leaf );
 }
 
 /**
@@ -406,41 +722,43 @@ t_node< K > *t_btree< K >::search( const K &key, t_node< K > *leaf ) const
 
 /**
  * @brief The traverse function iterates over the nodes in forward or reverse directions
+ * @details The traversal is iterative.  The nodes on the way down to the next key are kept on a stack in a local array, which an
+ * AVL tree never fills since its height is bounded by max_height.
  * @tparam K - Ordinal type K - must support <, > and == comparison operations.
- * @param [in] node - The current t_node< K > being traversed
- * @param [in] sum - The cumulative sum of counts for this subtree
- * @param [in] func - Optional function which can be used for custom t_node< K > processing during traversal
+ * @tparam F - The visitor type.
+ * @param [in] func - Optional visitor which can be used for custom t_node< K > processing during traversal
  * @param [in] forward - Boolean value indicating if forward (true) or reverse (false) traversal is required
- * @return long - Returns the total number of counts from all nodes in the tree
+ * @return long - Returns the total number of counts from all nodes visited
  */
 template < class K >
-long t_btree< K >::traverse( t_node< K > *node, long &sum, void (*func)( const K &key, long count ), bool forward ) const
+template < class F >
+long t_btree< K >::traverse( F &func, bool forward ) const
 {
-    // The forward argument controls the direction of traversal and defaults to true meaning in forward sort order
+    t_node< K > *stack[ max_height ];
+    t_node< K > *leaf = root;
+    int depth = 0;
+    long sum = 0;
 
-    // Anything in the subtree at all?
-    if ( node != nullptr ) 
+    // The forward argument controls the direction of traversal, which is forward sort order when true
+    while ( leaf != nullptr || depth > 0 )
     {
-        // Traverse the left or right subtree depending on the forward direction setting
-        if ( forward )
-            traverse( node->left, sum, func, forward );
-        else
-            traverse( node->right, sum, func, forward );
-
-        // If there is a callback function during traverse call it
-        if ( func )
+        // Descend to the next key in the direction of traversal, remembering the nodes passed on the way
+        while ( leaf != nullptr )
         {
-            (*func)( node->key_value, node->count );
+            stack[ depth++ ] = leaf;
+            leaf = forward ? leaf->left : leaf->right;
         }
 
-        // Add the node count to the sum
-        sum += node->count;
+        leaf = stack[ --depth ];
 
-        // Traverse the right or left subtree depending on the forward direction setting
-        if ( forward )
-            traverse( node->right, sum, func, forward );
-        else
-            traverse( node->left, sum, func, forward );
+        // Add the node count to the sum and call the visitor, which may end the traversal
+        sum += leaf->count;
+
+        if ( !t_visit( func, leaf->key_value, leaf->count ) )
+            break;
+
+        // Continue with the subtree on the far side of the node
+        leaf = forward ? leaf->right : leaf->left;
     }
 
     return sum;
@@ -463,9 +781,8 @@ t_node< K >* t_btree< K >::duplicate( t_node< K > *nptr )
         return nullptr;
 
     // Create a new node and copy the contents
-    t_node< K > *node_copy = new t_node< K >;
-    node_copy->count = nptr->count;
-    node_copy->key_value = nptr->key_value;
+    t_node< K > *node_copy = new_node( nptr->key_value, nptr->count );
+    node_copy->height = nptr->height;
 
     // Now copy the left and right subtrees
     node_copy->left = duplicate( nptr->left );
@@ -474,26 +791,243 @@ t_node< K >* t_btree< K >::duplicate( t_node< K > *nptr )
     return node_copy;
 }
 
+/**
+ * @brief Allocate a new node holding a key
+ * @details With an arena the node is placed in it and the key is copied with the arena current, even if it could be moved, so
+ * that whatever memory the key needs comes from the arena.  Otherwise the node is allocated from the heap and an rvalue key is
+ * moved into it.
+ * @tparam K - Ordinal type K - must support <, > and == comparison operations.
+ * @tparam Q - The key type, which is either a const reference or an rvalue reference to K.
+ * @param [in] key - The key to copy or move into the node.
+ * @param [in] count - The initial count (frequency) of the node.
+ * @return t_node< K >* - Pointer to the new node with no subtrees.
+ */
+template < class K >
+template < class Q >
+t_node< K > *t_btree< K >::new_node( Q &&key, ulong count )
+{
+    t_node< K > *leaf;
+
+    if ( pool )
+    {
+        arena::scope current( pool );
+
+        leaf = new ( pool->allocate( sizeof( t_node< K > ), alignof( t_node< K > ) ) ) t_node< K >;
+        leaf->key_value = static_cast< const K & >( key );
+    }
+    else
+    {
+        leaf = new t_node< K >;
+        leaf->key_value = std::forward< Q >( key );
+    }
+
+    leaf->count = count;
+    return leaf;
+}
+
+/**
+ * @brief Return the height of a subtree
+ * @tparam K - Ordinal type K - must support <, > and == comparison operations.
+ * @param [in] leaf - The root of the subtree or nullptr.
+ * @return int - The height, which is 0 for an empty subtree.
+ */
+template < class K >
+int t_btree< K >::height( const t_node< K > *leaf )
+{
+    return leaf ? leaf->height : 0;
+}
+
+/**
+ * @brief Rotate a subtree to the left so that its right child becomes its root
+ * @tparam K - Ordinal type K - must support <, > and == comparison operations.
+ * @param [in] leaf - The root of the subtree, which must have a right child.
+ * @return t_node< K >* - The new root of the subtree.
+ */
+template < class K >
+t_node< K > *t_btree< K >::rotate_left( t_node< K > *leaf )
+{
+    t_node< K > *pivot = leaf->right;
+
+    leaf->right = pivot->left;
+    pivot->left = leaf;
+
+    // The old root is now below the pivot so its height is settled first
+    leaf->height = 1 + std::max( height( leaf->left ), height( leaf->right ) );
+    pivot->height = 1 + std::max( height( pivot->left ), height( pivot->right ) );
+
+    return pivot;
+}
+
+/**
+ * @brief Rotate a subtree to the right so that its left child becomes its root
+ * @tparam K - Ordinal type K - must support <, > and == comparison operations.
+ * @param [in] leaf - The root of the subtree, which must have a left child.
+ * @return t_node< K >* - The new root of the subtree.
+ */
+template < class K >
+t_node< K > *t_btree< K >::rotate_right( t_node< K > *leaf )
+{
+    t_node< K > *pivot = leaf->left;
+
+    leaf->left = pivot->right;
+    pivot->right = leaf;
+
+    // The old root is now below the pivot so its height is settled first
+    leaf->height = 1 + std::max( height( leaf->left ), height( leaf->right ) );
+    pivot->height = 1 + std::max( height( pivot->left ), height( pivot->right ) );
+
+    return pivot;
+}
+
+/**
+ * @brief Restore the AVL balance of a subtree after one of its children grew by one level
+ * @details A subtree whose children differ in height by two is rotated toward the shorter side.  When the taller child leans
+ * the other way it is rotated first, which is the double rotation of an AVL tree.  Otherwise only the height is updated.
+ * @tparam K - Ordinal type K - must support <, > and == comparison operations.
+ * @param [in] leaf - The root of the subtree, whose children are balanced.
+ * @return t_node< K >* - The root of the balanced subtree.
+ */
+template < class K >
+t_node< K > *t_btree< K >::balance( t_node< K > *leaf )
+{
+    int skew = height( leaf->left ) - height( leaf->right );
+
+    if ( skew > 1 )
+    {
+        if ( height( leaf->left->left ) < height( leaf->left->right ) )
+            leaf->left = rotate_left( leaf->left );
+
+        return rotate_right( leaf );
+    }
+
+    if ( skew < -1 )
+    {
+        if ( height( leaf->right->right ) < height( leaf->right->left ) )
+            leaf->right = rotate_right( leaf->right );
+
+        return rotate_left( leaf );
+    }
+
+    leaf->height = 1 + std::max( height( leaf->left ), height( leaf->right ) );
+
+    return leaf;
+}
+
+/**
+ * @brief Free a node which is no longer in the tree
+ * @details A node in an arena only has its destructor called since the arena releases its memory all at once.
+ * @tparam K - Ordinal type K - must support <, > and == comparison operations.
+ * @param [in] leaf - The node to free.
+ */
+template < class K >
+void t_btree< K >::free_node( t_node< K > *leaf )
+{
+    if ( pool )
+        leaf->~t_node< K >();
+    else
+        delete leaf;
+}
+
+/**
+ * @brief Decide whether another tree is small enough that inserting its keys beats a linear merge
+ * @details Inserting m keys costs about m log2( n ) comparisons against n + m for the linear merge and rebuild.
+ * @tparam K - Ordinal type K - must support <, > and == comparison operations.
+ * @param [in] count - The number of nodes m in the other tree.
+ * @return true  - Returns true  if the keys should be inserted one at a time.
+ * @return false - Returns false if the trees should be merged in linear time.
+ */
+template < class K >
+bool t_btree< K >::merge_by_insert( ulong count ) const
+{
+    return count * std::bit_width( node_count ) < node_count + count;
+}
+
+/**
+ * @brief List the nodes of the tree in forward sort order
+ * @details The nodes are walked iteratively with the same bounded stack as traverse().
+ * @tparam K - Ordinal type K - must support <, > and == comparison operations.
+ * @param [out] list - The list the nodes are appended to.
+ */
+template < class K >
+void t_btree< K >::flatten( std::vector< t_node< K > * > &list ) const
+{
+    t_node< K > *stack[ max_height ];
+    t_node< K > *leaf = root;
+    int depth = 0;
+
+    list.reserve( list.size() + node_count );
+
+    while ( leaf != nullptr || depth > 0 )
+    {
+        while ( leaf != nullptr )
+        {
+            stack[ depth++ ] = leaf;
+            leaf = leaf->left;
+        }
+
+        leaf = stack[ --depth ];
+        list.push_back( leaf );
+        leaf = leaf->right;
+    }
+}
+
+/**
+ * @brief Build a balanced tree from a sorted list of nodes
+ * @details The middle node becomes the root and each half is built the same way, so the heights of the two subtrees of every
+ * node differ by at most one, which is a valid AVL tree.
+ * @tparam K - Ordinal type K - must support <, > and == comparison operations.
+ * @param [in] first - The first node of the list.
+ * @param [in] count - The number of nodes in the list.
+ * @return t_node< K >* - The root of the tree, or nullptr if the list is empty.
+ */
+template < class K >
+t_node< K > *t_btree< K >::build( t_node< K > **first, size_t count )
+{
+    if ( count == 0 )
+        return nullptr;
+
+    size_t middle = count / 2;
+    t_node< K > *leaf = first[ middle ];
+
+    leaf->left = build( first, middle );
+    leaf->right = build( first + middle + 1, count - middle - 1 );
+    leaf->height = 1 + std::max( height( leaf->left ), height( leaf->right ) );
+
+    return leaf;
+}
+
 /**
  * @brief Destroys current node and subtending nodes
  * @details This function can be used to destroy any subtree of a binary tree.  If called using the root t_node< K > as
- * the starting point it will destroy the entire t_btree< K >.  The function recursively calls for the destruction of the
- * left and right subtrees and upon return frees the current node.
+ * the starting point it will destroy the entire t_btree< K >.  The destruction is iterative and needs no stack.  Whenever the
+ * current node has a left subtree it is rotated right, so the node freed next never has one and the tree unwinds into a list
+ * which is freed from its smallest key up.
  * @tparam K - Ordinal type K - must support <, > and == comparison operations.
  * @param [in] leaf - The current node (and subtree) freed.
  */
 template < class K >
 void t_btree< K >::destroy_tree( t_node< K > *leaf )
 {
-    // If the current node is not null then destruction is required
-    if ( leaf != nullptr )
+    while ( leaf != nullptr )
     {
-        // Prior to destroying the current node recursively destroy left and right subtrees
-        destroy_tree( leaf->left );
-        destroy_tree( leaf->right );
+        // Rotate the left subtree up above the current node
+        if ( leaf->left != nullptr )
+        {
+            t_node< K > *pivot = leaf->left;
 
-        // Once subtrees are destroyed free up the memory allocated for the current node
-        delete leaf;
+            leaf->left = pivot->right;
+            pivot->right = leaf;
+            leaf = pivot;
+        }
+
+        // Otherwise free the node, which the arena does all at once, and continue with its right subtree
+        else
+        {
+            t_node< K > *next = leaf->right;
+
+            free_node( leaf );
+            leaf = next;
+        }
     }
 }
 
@@ -507,3 +1041,19 @@ void t_btree< K >::zeroize()
     root = nullptr;
     node_count = 0;
 }
+
+/**
+ * @brief Merge each histogram of one array into the histogram at the same index of another
+ * @details The scan drivers keep a histogram for each length, so per-worker partial results are combined one length at a time.
+ * The histograms of the second array are moved from and left empty.
+ * @tparam T - The histogram type, which needs a merge( T && ) member (e.g. t_btree< K >, t_hist< K >, dense_histogram).
+ * @param [in,out] into - The array of histograms to merge into.
+ * @param [in,out] from - The array of histograms to merge from.
+ * @param [in] count - The number of histograms in each array.
+ */
+template < class T >
+void merge_each( T *into, T *from, long count )
+{
+    for ( long i = 0; i < count; ++i )
+        into[ i ].merge( std::move( from[ i ] ) );
+}
@@ -73,6 +73,16 @@ static_assert(__cplusplus >= 202002L,
 #include <gmpxx.h>          // C++ header file (which in turn calls C header file <gmp.h>)
 #endif
 
+/**
+ * @def gnu_int128
+ * @brief The gnu_int128 define is set automatically when the compiler furnishes native 128-bit integers.  The standard library
+ * only treats __int128 as an integral type when GNU extensions are enabled (e.g. -std=gnu++20 rather than -std=c++20), so
+ * strict ISO builds leave the 128-bit path variants out.
+ */
+#if defined( __SIZEOF_INT128__ ) && !defined( __STRICT_ANSI__ )
+#define gnu_int128
+#endif
+
 // Class forward declarations
 class btree;
 template < class K > class t_btree;
@@ -124,6 +134,9 @@ class statics
         // Global flags
         static bool speed;                              /**< Speed flag (boolean) for execution which takes shortcuts */
         static int  blip_modulus;                       /**< Integer which detmineds how often to display progress blip */
+        static int  jump_bits;                          /**< Residue bits k of the orbit jump table, 0 disables jumps */
+        static int  sieve_bits;                         /**< Residue bits k of the scan driver sieve, 0 disables the sieve */
+        static int  memo_bits;                          /**< Bits k of the stop table bound 2^k, 0 disables the table */
 
         // Print control values
         static int count;                               /**< Number of digits in base 10 representation */
@@ -141,6 +154,11 @@ enum class collatz_regime : uint8_t {
 
 typedef unsigned long ulong;                            /**< This typedef provides a shorthand notation 'ulong' in place of 'unsigned long'. */
 
+#ifdef gnu_int128
+typedef __int128 int128_t;                              /**< Signed native 128-bit integer in the style of the <stdint.h> typedefs. */
+typedef unsigned __int128 uint128_t;                    /**< Unsigned native 128-bit integer in the style of the <stdint.h> typedefs. */
+#endif
+
 // Global Templates
 
 /**
@@ -0,0 +1,122 @@
+/**
+ * @file histogram.cpp
+ * @author Wayne Brassem (wbrassem@rogers.com)
+ * @brief Implementation of the dense histogram of small non-negative integer keys.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023-2026 Wayne Brassem
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+#include "common.hpp"
+#include "histogram.hpp"
+
+/**
+ * @brief Construct an empty histogram
+ * @details Room is made for the keys below 64 up front, which covers every path length of a typical scan.
+ */
+dense_histogram::dense_histogram() : counts( 64, 0 )
+{
+}
+
+/**
+ * @brief Return the count of a key
+ * @param [in] key - The key to search for.
+ * @return long - The count of the key, or 0 if it has never been counted.
+ */
+long dense_histogram::search( long key ) const
+{
+    return ( key >= 0 && ulong( key ) < counts.size() ) ? counts[ key ] : 0;
+}
+
+/**
+ * @brief Merge another histogram into this one, summing the counts of every key
+ * @details The counters are added element by element, growing this histogram first if the other one holds larger keys.
+ * @param [in] histogram - Constant reference to the histogram to merge into this one.
+ */
+void dense_histogram::merge( const dense_histogram &histogram )
+{
+    if ( histogram.counts.size() > counts.size() )
+        counts.resize( histogram.counts.size(), 0 );
+
+    std::transform( histogram.counts.begin(), histogram.counts.end(), counts.begin(), counts.begin(), std::plus< ulong >() );
+}
+
+/**
+ * @brief Iterates over the keys with a non-zero count in ascending order
+ * @param [in] func - Optional function pointer accepting the key and count values, which is called for each key in turn.
+ * @return long - Returns the sum of the counts of all keys.
+ */
+long dense_histogram::constForwardIterator( void (*func)( long key, long count ) ) const
+{
+    long sum = 0;
+
+    for ( size_t key = 0; key < counts.size(); ++key )
+    {
+        if ( counts[ key ] == 0 )
+            continue;
+
+        if ( func )
+            (*func)( key, counts[ key ] );
+
+        sum += counts[ key ];
+    }
+
+    return sum;
+}
+
+/**
+ * @brief Iterates over the keys with a non-zero count in descending order
+ * @param [in] func - Optional function pointer accepting the key and count values, which is called for each key in turn.
+ * @return long - Returns the sum of the counts of all keys.
+ */
+long dense_histogram::constReverseIterator( void (*func)( long key, long count ) ) const
+{
+    long sum = 0;
+
+    for ( size_t key = counts.size(); key-- > 0; )
+    {
+        if ( counts[ key ] == 0 )
+            continue;
+
+        if ( func )
+            (*func)( key, counts[ key ] );
+
+        sum += counts[ key ];
+    }
+
+    return sum;
+}
+
+/**
+ * @brief Return the number of distinct keys counted, which is the number of nodes a btree would have
+ * @return long - The number of keys with a non-zero count.
+ */
+long dense_histogram::nodes() const
+{
+    return counts.size() - std::count( counts.begin(), counts.end(), 0 );
+}
+
+/**
+ * @brief Reset every count to zero, keeping the counters already allocated
+ */
+void dense_histogram::clear()
+{
+    std::fill( counts.begin(), counts.end(), 0 );
+}
+
+/**
+ * @brief Extend the counters so that they hold a key
+ * @details The counters at least double so that a run of ever larger keys only grows them a logarithmic number of times.
+ * @param [in] key - The key which is beyond the counters.
+ */
+void dense_histogram::grow( long key )
+{
+    if ( key < 0 )
+        throw std::out_of_range( "Histogram keys must not be negative." );
+
+    counts.resize( std::max( 2 * counts.size(), size_t( key ) + 1 ), 0 );
+}
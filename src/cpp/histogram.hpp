@@ -0,0 +1,503 @@
+/**
+ * @file histogram.hpp
+ * @author Wayne Brassem (wbrassem@rogers.com)
+ * @brief The dense_histogram class counts small non-negative integer keys such as path lengths in a plain array of counters,
+ * and the t_hist< K > template counts arbitrary keys such as pathways in a hash table which is only sorted for output
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023-2026 Wayne Brassem
+ *
+ */
+
+#pragma once
+#include "common.hpp"
+#include "btree.hpp"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+/**
+ * @brief The dense_histogram class is a drop in replacement for btree when the keys are small non-negative integers
+ * @details The count of each key is held at that index of an array, so counting an integer is a single array increment rather
+ * than a walk down a tree and a heap node for every distinct key.  The array grows to twice the largest key seen whenever a key
+ * falls beyond it, and keys which never occur simply keep a zero count.  The iterators visit only the keys with a non-zero count,
+ * in key order, so the callbacks written for btree produce exactly the same output.
+ *
+ * Path lengths and equivalence class lengths are bounded by a few hundred even for the longest scans, which keeps the array
+ * small.  The counters are 64-bit, so the counts of the largest ranges do not overflow.
+ */
+class dense_histogram
+{
+    public:
+        dense_histogram();
+
+        inline void insert( long key );                 // Count one instance of a key
+        inline void insert( long key, ulong count );    // Count a number of instances of a key at once
+        long search( long key ) const;                  // Returns the count for a given key
+
+        // Merge another histogram into this one, summing the counts of every key
+        void merge( const dense_histogram &histogram );
+        inline void merge( dense_histogram &&histogram );
+
+        // const Iterators take an optional function pointer which passed in the key and count values as long
+        long constForwardIterator( void (*func)( long key, long count ) = nullptr ) const;
+        long constReverseIterator( void (*func)( long key, long count ) = nullptr ) const;
+
+        long nodes() const;                             // Return the number of keys with a non-zero count
+        void clear();                                   // Reset every count to zero
+
+    protected:
+        void grow( long key );                          // Extend the counters to hold a key
+
+        std::vector< ulong > counts;                    /**< The count of each key indexed by the key. */
+};
+
+/**
+ * @brief Merge another histogram into this one, leaving the other one empty
+ * @param [in] histogram - The histogram to merge and then clear.
+ */
+void dense_histogram::merge( dense_histogram &&histogram )
+{
+    merge( static_cast< const dense_histogram & >( histogram ) );
+    histogram.clear();
+}
+
+/**
+ * @brief Count one instance of a key
+ * @param [in] key - The non-negative key to count.
+ */
+void dense_histogram::insert( long key )
+{
+    insert( key, 1 );
+}
+
+/**
+ * @brief Count a number of instances of a key at once
+ * @details A negative key converts to an unsigned index beyond any array, so the one comparison both catches it and finds a key
+ * which needs the counters to grow.
+ * @param [in] key - The non-negative key to count.
+ * @param [in] count - The number of instances of the key to add.
+ */
+void dense_histogram::insert( long key, ulong count )
+{
+    if ( ulong( key ) >= counts.size() )
+        grow( key );
+
+    counts[ key ] += count;
+}
+
+
+/**
+ * @brief The templated t_hist< K > class counts keys of type K with the same interface as t_btree< K >
+ * @details Keys are counted in an open addressing hash table rather than a tree, so a scan which inserts tens of millions of keys
+ * pays an amortized constant time hash probe for each of them instead of a walk down a tree of pointers.  Each distinct key is
+ * kept once with its count and hash in an array in the order it was first seen, and the table holds the index of each entry plus
+ * one, where zero is an empty slot.  The table is kept at most half full and is probed linearly from a slot chosen by Fibonacci
+ * hashing, so probes stay short and walk adjacent memory.
+ *
+ * The iterators visit the keys in sorted order, which is only worked out when they are called.  The order is then kept until the
+ * next new key arrives, so a forward and a reverse pass share a single sort.
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K, which is std::hash< K > by default.
+ */
+template < class K, class H = std::hash< K > >
+class t_hist
+{
+    public:
+        t_hist();
+
+        void insert( const K &key );
+        void insert( const K &key, ulong count );       // Insert or increment by a number of instances at once
+        void insert( K &&key );                         // Insert by moving the key into a new entry
+        void insert( K &&key, ulong count );
+        template < class... A > void emplace( A&&... args );    // Insert a key built from constructor arguments
+        long search( const K &key ) const;
+
+        // Merge another histogram into this one, summing the counts of keys found in both
+        void merge( const t_hist< K, H > &histogram );
+        void merge( t_hist< K, H > &&histogram );       // Merge by moving the keys of the other histogram
+
+        // const Iterators take an optional callable which is passed the key and count, and stops early by returning false
+        template < class F = std::nullptr_t > inline long constForwardIterator( F &&func = nullptr ) const;
+        template < class F = std::nullptr_t > inline long constReverseIterator( F &&func = nullptr ) const;
+
+        long nodes() const;                             // Return number of distinct keys
+        void destroy_tree();                            // Remove every key, named as in t_btree< K >
+
+    protected:
+        /** @brief A distinct key with its count and hash */
+        struct entry
+        {
+            K       key_value;                          /**< Key of type K holding the key_value. */
+            ulong   count;                              /**< Value used to provide ordinal instance counts. */
+            size_t  hash;                               /**< Hash of the key, kept so the table can grow without hashing again. */
+        };
+
+        template < class Q > void insert_key( Q &&key, ulong count, size_t hash );
+        size_t find( const K &key, size_t hash ) const; // Slot holding the key or the empty slot where it belongs
+        inline size_t slot( size_t hash ) const;
+        void grow();
+        template < class F > long traverse( F &func, bool forward ) const;
+
+        std::vector< entry > entries;                   /**< Every distinct key in the order it was first seen. */
+        std::vector< uint32_t > slots;                  /**< Hash table of entry indices plus one, where zero is an empty slot. */
+        int shift;                                      /**< Right shift taking a mixed hash to a slot index. */
+        mutable std::vector< uint32_t > order;          /**< Entry indices in key order, or empty until the next export. */
+        H hasher;                                       /**< The hash function object. */
+};
+
+// Template definitions
+
+// t_hist< K, H > public member functions
+
+/**
+ * @brief Default constructor for an empty t_hist< K, H > object
+ * @details The hash table starts with 1024 slots and doubles whenever it would become more than half full.
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K.
+ */
+template < class K, class H >
+t_hist< K, H >::t_hist() : slots( 1024, 0 ), shift( 64 - 10 )
+{
+}
+
+/**
+ * @brief Public insert function to count one instance of a key
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K.
+ * @param [in] key - The key of type K to add or count (frequency) to increment if found.
+ */
+template < class K, class H >
+void t_hist< K, H >::insert( const K &key )
+{
+    insert_key( key, 1, hasher( key ) );
+}
+
+/**
+ * @brief Public insert function to count a number of instances of a key at once
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K.
+ * @param [in] key - The key of type K to add or count (frequency) to increment if found.
+ * @param [in] count - The number of instances of the key to add.
+ */
+template < class K, class H >
+void t_hist< K, H >::insert( const K &key, ulong count )
+{
+    insert_key( key, count, hasher( key ) );
+}
+
+/**
+ * @brief Public insert function to count one instance of a key, moving the key in if it is new
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K.
+ * @param [in] key - The key of type K to add or count (frequency) to increment if found.
+ */
+template < class K, class H >
+void t_hist< K, H >::insert( K &&key )
+{
+    insert_key( std::move( key ), 1, hasher( key ) );
+}
+
+/**
+ * @brief Public insert function to count a number of instances of a key at once, moving the key in if it is new
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K.
+ * @param [in] key - The key of type K to add or count (frequency) to increment if found.
+ * @param [in] count - The number of instances of the key to add.
+ */
+template < class K, class H >
+void t_hist< K, H >::insert( K &&key, ulong count )
+{
+    insert_key( std::move( key ), count, hasher( key ) );
+}
+
+/**
+ * @brief Public insert function to count a key given the arguments of a K constructor
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K.
+ * @tparam A - The types of the constructor arguments.
+ * @param [in] args - The arguments passed on to the K constructor.
+ */
+template < class K, class H >
+template < class... A >
+void t_hist< K, H >::emplace( A&&... args )
+{
+    K key( std::forward< A >( args )... );
+
+    insert_key( std::move( key ), 1, hasher( key ) );
+}
+
+/**
+ * @brief Public search function which looks for a key
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K.
+ * @param [in] key - The key of type K to search for.
+ * @return long - Return the count (frequency) of the key, or 0 if it is not found.
+ */
+template < class K, class H >
+long t_hist< K, H >::search( const K &key ) const
+{
+    uint32_t index = slots[ find( key, hasher( key ) ) ];
+
+    return index ? entries[ index - 1 ].count : 0;
+}
+
+/**
+ * @brief Merge a copy of another histogram into this one, summing the counts of the keys found in both
+ * @details Every entry of the other histogram is counted here with its saved hash, so no key is hashed again and the merge takes
+ * linear time in the number of keys of the other histogram.  The other histogram is left unchanged.
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K.
+ * @param [in] histogram - Constant reference to the t_hist< K, H > to merge into this one.
+ */
+template < class K, class H >
+void t_hist< K, H >::merge( const t_hist< K, H > &histogram )
+{
+    // Merging a histogram with itself doubles every count, and the entries must not grow while they are read
+    if ( this == &histogram )
+    {
+        for ( entry &e : entries )
+            e.count *= 2;
+
+        return;
+    }
+
+    for ( const entry &e : histogram.entries )
+        insert_key( e.key_value, e.count, e.hash );
+}
+
+/**
+ * @brief Merge another histogram into this one by moving its keys, summing the counts of the keys found in both
+ * @details The same as merge( const t_hist< K, H > & ) except that the keys which are new to this histogram are moved rather than
+ * copied.  The other histogram is left empty.
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K.
+ * @param [in] histogram - The t_hist< K, H > to take the keys from.
+ */
+template < class K, class H >
+void t_hist< K, H >::merge( t_hist< K, H > &&histogram )
+{
+    if ( this == &histogram )
+        return;
+
+    for ( entry &e : histogram.entries )
+        insert_key( std::move( e.key_value ), e.count, e.hash );
+
+    histogram.destroy_tree();
+}
+
+/**
+ * @brief Iterates over the keys in forward sort order
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K.
+ * @tparam F - The visitor type, which is deduced.
+ * @param [in] func - Optional visitor accepting a reference to the const key of type K and the count, which may be a function
+ * pointer or any callable.  A visitor returning bool ends the iteration by returning false.
+ * @return long - Returns the sum of counts of all keys visited.
+ * @see t_visit
+ */
+template < class K, class H >
+template < class F >
+long t_hist< K, H >::constForwardIterator( F &&func ) const
+{
+    return traverse( func, true );
+}
+
+/**
+ * @brief Iterates over the keys in reverse sort order
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K.
+ * @tparam F - The visitor type, which is deduced.
+ * @param [in] func - Optional visitor accepting a reference to the const key of type K and the count, which may be a function
+ * pointer or any callable.  A visitor returning bool ends the iteration by returning false.
+ * @return long - Returns the sum of counts of all keys visited.
+ * @see t_visit
+ */
+template < class K, class H >
+template < class F >
+long t_hist< K, H >::constReverseIterator( F &&func ) const
+{
+    return traverse( func, false );
+}
+
+/**
+ * @brief Function which returns the number of distinct keys, which is the number of nodes a t_btree< K > would have
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K.
+ * @return long - Return the number of distinct keys.
+ */
+template < class K, class H >
+long t_hist< K, H >::nodes() const
+{
+    return entries.size();
+}
+
+/**
+ * @brief Removes every key and frees the memory they held, leaving the hash table at its initial size
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K.
+ */
+template < class K, class H >
+void t_hist< K, H >::destroy_tree()
+{
+    std::vector< entry >().swap( entries );
+    std::vector< uint32_t >( 1024, 0 ).swap( slots );
+    std::vector< uint32_t >().swap( order );
+
+    shift = 64 - 10;
+}
+
+
+// t_hist< K, H > protected member functions
+
+/**
+ * @brief Count a key, adding a new entry for it if it has not been seen before
+ * @details The key is only copied or moved into the entry when it is new.  An rvalue key which is already counted is left as it
+ * was.
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K.
+ * @tparam Q - The key type, which is either a const reference or an rvalue reference to K.
+ * @param [in] key - The key of type K to add or count (frequency) to increment if found.
+ * @param [in] count - The number of instances of the key to add.
+ * @param [in] hash - The hash of the key.
+ */
+template < class K, class H >
+template < class Q >
+void t_hist< K, H >::insert_key( Q &&key, ulong count, size_t hash )
+{
+    // Nothing to add
+    if ( count == 0 )
+        return;
+
+    size_t i = find( key, hash );
+
+    // If the key is found increment the frequency
+    if ( slots[ i ] != 0 )
+    {
+        entries[ slots[ i ] - 1 ].count += count;
+        return;
+    }
+
+    // Keep the table at most half full so probe sequences stay short, which moves the empty slot for the key
+    if ( 2 * ( entries.size() + 1 ) > slots.size() )
+    {
+        grow();
+        i = find( key, hash );
+    }
+
+    // Entry indices are stored plus one in the table, so the largest 32-bit value is never used
+    if ( entries.size() >= UINT32_MAX )
+        throw std::length_error( "Histogram exceeds the range of 32-bit entry indices." );
+
+    entries.push_back( { std::forward< Q >( key ), count, hash } );
+    slots[ i ] = entries.size();
+}
+
+/**
+ * @brief Find the slot of a key
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K.
+ * @param [in] key - The key of type K to search for.
+ * @param [in] hash - The hash of the key.
+ * @return size_t - The slot holding the index of the key, or the empty slot where it belongs if it is not in the table.
+ */
+template < class K, class H >
+size_t t_hist< K, H >::find( const K &key, size_t hash ) const
+{
+    size_t mask = slots.size() - 1;
+    size_t i = slot( hash );
+
+    // Probe until the key or an empty slot is found, only comparing keys whose hashes agree
+    for ( ; slots[ i ] != 0; i = ( i + 1 ) & mask )
+    {
+        const entry &e = entries[ slots[ i ] - 1 ];
+
+        if ( e.hash == hash && e.key_value == key )
+            break;
+    }
+
+    return i;
+}
+
+/**
+ * @brief Return the home slot of a hash
+ * @details The hash is mixed by a Fibonacci multiplier and the top bits are used, so every bit of it affects the slot.
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K.
+ * @param [in] hash - The hash of a key.
+ * @return size_t - Index of the first slot to probe.
+ */
+template < class K, class H >
+size_t t_hist< K, H >::slot( size_t hash ) const
+{
+    return ( uint64_t( hash ) * 0x9e3779b97f4a7c15 ) >> shift;
+}
+
+/**
+ * @brief Double the hash table and insert every entry again from its saved hash
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K.
+ */
+template < class K, class H >
+void t_hist< K, H >::grow()
+{
+    std::vector< uint32_t > grown( 2 * slots.size(), 0 );
+
+    slots.swap( grown );
+    shift--;
+
+    size_t mask = slots.size() - 1;
+
+    for ( uint32_t index = 0; index < entries.size(); ++index )
+    {
+        size_t i = slot( entries[ index ].hash );
+
+        while ( slots[ i ] != 0 )
+            i = ( i + 1 ) & mask;
+
+        slots[ i ] = index + 1;
+    }
+}
+
+/**
+ * @brief The traverse function visits the keys in forward or reverse sort order
+ * @details The entry indices are sorted by key the first time they are needed after a new key was added.
+ * @tparam K - Key type K - must support < and == comparison operations.
+ * @tparam H - Hash function object for K.
+ * @tparam F - The visitor type.
+ * @param [in] func - Optional visitor which can be used for custom key processing during traversal
+ * @param [in] forward - Boolean value indicating if forward (true) or reverse (false) traversal is required
+ * @return long - Returns the total number of counts from all keys visited
+ */
+template < class K, class H >
+template < class F >
+long t_hist< K, H >::traverse( F &func, bool forward ) const
+{
+    long sum = 0;
+
+    // Sort the keys once for every export following new keys
+    if ( order.size() != entries.size() )
+    {
+        order.resize( entries.size() );
+
+        for ( uint32_t index = 0; index < entries.size(); ++index )
+            order[ index ] = index;
+
+        std::sort( order.begin(), order.end(),
+                   [ this ]( uint32_t a, uint32_t b ) { return entries[ a ].key_value < entries[ b ].key_value; } );
+    }
+
+    for ( size_t n = 0; n < order.size(); ++n )
+    {
+        const entry &e = entries[ forward ? order[ n ] : order[ order.size() - 1 - n ] ];
+
+        // Add the key count to the sum and call the visitor, which may end the traversal
+        sum += e.count;
+
+        if ( !t_visit( func, e.key_value, e.count ) )
+            break;
+    }
+
+    return sum;
+}
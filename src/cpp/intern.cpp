@@ -0,0 +1,209 @@
+/**
+ * @file intern.cpp
+ * @author Wayne Brassem (wbrassem@rogers.com)
+ * @brief Implementation of the orbit interning store which keeps one copy of every distinct orbit under a 32-bit identifier.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023-2026 Wayne Brassem
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include "common.hpp"
+#include "intern.hpp"
+
+/**
+ * @brief Construct an empty store
+ * @details The hash table starts with 1024 slots and doubles whenever it would become more than half full.
+ */
+orbit_store::orbit_store() : slots( 1024, 0 ), shift( 64 - 10 )
+{
+}
+
+/**
+ * @brief Return the identifier of an orbit, storing the orbit first if it has not been seen before
+ * @details The slot is found from the orbit fingerprint, and an identifier in the table only matches if its fingerprint, path
+ * length, code length and unions all agree with the orbit.
+ * @param [in] o - Const reference to the orbit to intern.
+ * @return uint32_t - The identifier of the orbit.
+ */
+uint32_t orbit_store::intern( const orbit_t &o )
+{
+    return intern( { o.hash_key, 0, o.path_length, o.code_length }, o.keys );
+}
+
+/**
+ * @brief Return the identifier of an orbit given by its entry and unions, storing the orbit first if it has not been seen before
+ * @param [in] o - The fingerprint, path length and code length of the orbit.  The offset is not used.
+ * @param [in] o_keys - The unions holding the codes of the orbit.
+ * @return uint32_t - The identifier of the orbit.
+ */
+uint32_t orbit_store::intern( const entry &o, const orbit_key_t *o_keys )
+{
+    // Keep the table at most half full so probe sequences stay short
+    if ( 2 * ( entries.size() + 1 ) > slots.size() )
+        grow();
+
+    int count = words( o.code_length );
+    size_t mask = slots.size() - 1;
+    size_t i = slot( o.hash );
+
+    // Probe until the orbit or an empty slot is found
+    for ( ; slots[ i ] != 0; i = ( i + 1 ) & mask )
+    {
+        const entry &e = entries[ slots[ i ] - 1 ];
+
+        if ( e.hash == o.hash && e.path_length == o.path_length && e.code_length == o.code_length
+            && std::equal( o_keys, o_keys + count, keys.begin() + e.offset,
+                           []( const orbit_key_t &a, const orbit_key_t &b ) { return a.i_key == b.i_key; } ) )
+            return slots[ i ] - 1;
+    }
+
+    // Identifiers are stored plus one in the table, so the largest 32-bit value is never handed out
+    if ( entries.size() >= UINT32_MAX )
+        throw std::length_error( "Orbit store exceeds the range of 32-bit identifiers." );
+
+    uint32_t id = entries.size();
+
+    entries.push_back( { o.hash, keys.size(), o.path_length, o.code_length } );
+    keys.insert( keys.end(), o_keys, o_keys + count );
+    slots[ i ] = id + 1;
+
+    return id;
+}
+
+/**
+ * @brief Rebuild the orbit for an identifier
+ * @param [in] id - Identifier returned by intern().
+ * @return orbit_t - A copy of the stored orbit.
+ */
+orbit_t orbit_store::orbit( uint32_t id ) const
+{
+    const entry &e = entries[ id ];
+    int count = words( e.code_length );
+    orbit_t o;
+
+    if ( !o.reserve( count ) )
+        return o;
+
+    std::copy( keys.begin() + e.offset, keys.begin() + e.offset + count, o.keys );
+
+    o.path_length = e.path_length;
+    o.code_length = e.code_length;
+    o.hash_key = e.hash;
+
+    return o;
+}
+
+/**
+ * @brief Return the orbital path of an identifier as a std::string object (e.g. "0 1 2 1 2 1 3")
+ * @param [in] id - Identifier returned by intern().
+ * @return std::string - The orbit elements separated by spaces.
+ */
+std::string orbit_store::path( uint32_t id ) const
+{
+    return view( id ).str();
+}
+
+/**
+ * @brief Intern every orbit of another store into this one
+ * @details The orbits are probed by their saved fingerprints and compared union by union, so no orbit is rebuilt.  The returned
+ * map lets the counts kept against the identifiers of the other store be added to the counts of this one, for example
+ * counts[ map[ id ] ] += other_counts[ id ].
+ * @param [in] store - Const reference to the store to merge into this one.
+ * @return std::vector< uint32_t > - The identifier in this store of each identifier of the other store.
+ */
+std::vector< uint32_t > orbit_store::merge( const orbit_store &store )
+{
+    std::vector< uint32_t > map( store.size() );
+
+    // Every orbit of a store is already in it, and interning would read unions which are being appended to
+    if ( &store == this )
+    {
+        for ( uint32_t id = 0; id < size(); ++id )
+            map[ id ] = id;
+
+        return map;
+    }
+
+    for ( uint32_t id = 0; id < store.size(); ++id )
+    {
+        const entry &e = store.entries[ id ];
+
+        map[ id ] = intern( e, &store.keys[ e.offset ] );
+    }
+
+    return map;
+}
+
+/**
+ * @brief Compare the orbits of two identifiers
+ * @details The orbits are ordered exactly as orbit_t orders them, lexicographically by their elements with the shorter orbit
+ * first when one is a prefix of the other.
+ * @param [in] a - Identifier of the first orbit.
+ * @param [in] b - Identifier of the second orbit.
+ * @return int - Negative, zero or positive if orbit a is less than, equal to or greater than orbit b.
+ */
+int orbit_store::compare( uint32_t a, uint32_t b ) const
+{
+    if ( a == b )
+        return 0;
+
+    const entry &ea = entries[ a ], &eb = entries[ b ];
+
+    return orbit_t::compare( &keys[ ea.offset ], ea.code_length, ea.path_length, &keys[ eb.offset ], eb.code_length, eb.path_length );
+}
+
+/**
+ * @brief Return the memory held by the store
+ * @return size_t - The bytes reserved for the unions, entries and hash table.
+ */
+size_t orbit_store::bytes() const
+{
+    return keys.capacity() * sizeof( orbit_key_t ) + entries.capacity() * sizeof( entry ) + slots.capacity() * sizeof( uint32_t );
+}
+
+/**
+ * @brief Return the number of unions holding an orbit
+ * @param [in] codes - The number of element codes in use.
+ * @return int - The number of unions, which is at least one even for an empty orbit.
+ */
+int orbit_store::words( int codes )
+{
+    return codes ? ( codes + orbit_t::word_codes - 1 ) / orbit_t::word_codes : 1;
+}
+
+/**
+ * @brief Return the home slot of a fingerprint
+ * @details The fingerprint is mixed by a Fibonacci multiplier and the top bits are used, so every bit of it affects the slot.
+ * @param [in] hash - The orbit fingerprint.
+ * @return size_t - Index of the first slot to probe.
+ */
+size_t orbit_store::slot( uint64_t hash ) const
+{
+    return ( hash * 0x9e3779b97f4a7c15 ) >> shift;
+}
+
+/**
+ * @brief Double the hash table and insert every identifier again
+ */
+void orbit_store::grow()
+{
+    std::vector< uint32_t > grown( 2 * slots.size(), 0 );
+
+    slots.swap( grown );
+    shift--;
+
+    size_t mask = slots.size() - 1;
+
+    for ( uint32_t id = 0; id < entries.size(); ++id )
+    {
+        size_t i = slot( entries[ id ].hash );
+
+        while ( slots[ i ] != 0 )
+            i = ( i + 1 ) & mask;
+
+        slots[ i ] = id + 1;
+    }
+}
@@ -0,0 +1,95 @@
+/**
+ * @file intern.hpp
+ * @author Wayne Brassem (wbrassem@rogers.com)
+ * @brief The orbit_store class keeps a single copy of every distinct orbit found during a scan and hands out compact 32-bit
+ * identifiers for them
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023-2026 Wayne Brassem
+ *
+ */
+
+#pragma once
+#include "common.hpp"
+#include "path.hpp"
+
+/**
+ * @brief The orbit_store class interns orbit_t objects so that each distinct orbit is stored exactly once
+ * @details The packed unions of every distinct orbit are appended to one contiguous array, and each orbit is known from then on
+ * by its 32-bit identifier, which counts up from zero in the order the orbits were first seen.  An open addressing hash table
+ * keyed by the orbit fingerprint finds the identifier of an orbit which is already in the store, so interning costs a hash
+ * probe and a comparison of the matching unions rather than a walk down a tree of orbit copies.
+ *
+ * Two identifiers from the same store are equal exactly when their orbits are, so histograms can count orbits in an array
+ * indexed by identifier.  Orbits are only ordered by compare() and read through view() when the results are printed.  Stores
+ * filled by separate workers are combined by merge(), which maps the identifiers of one store onto the other.
+ */
+class orbit_store
+{
+    public:
+        orbit_store();
+
+        uint32_t intern( const orbit_t &o );            // Identifier of the orbit, which is stored if it is new
+        orbit_t orbit( uint32_t id ) const;             // Rebuild the orbit for an identifier
+        std::string path( uint32_t id ) const;          // Orbital path as a std::string
+        inline orbit_view view( uint32_t id ) const;    // Read only view of the stored elements for printing
+        int compare( uint32_t a, uint32_t b ) const;    // Negative, zero or positive as orbit a is less, equal or greater
+        std::vector< uint32_t > merge( const orbit_store &store );  // Intern every orbit of another store
+
+        inline int path_len( uint32_t id ) const;
+        inline size_t size() const;
+        size_t bytes() const;                           // Memory held by the store
+
+    protected:
+        /** @brief Where a stored orbit lives in the array of unions and what is needed to recognize it */
+        struct entry
+        {
+            uint64_t    hash;                           /**< Fingerprint of the orbit. */
+            uint64_t    offset;                         /**< Index of the first union of the orbit. */
+            int32_t     path_length;                    /**< Number of orbit elements. */
+            int32_t     code_length;                    /**< Number of element codes in use. */
+        };
+
+        uint32_t intern( const entry &o, const orbit_key_t *o_keys );
+        inline static int words( int codes );
+        inline size_t slot( uint64_t hash ) const;
+        void grow();
+
+        std::vector< orbit_key_t > keys;                /**< The unions of every stored orbit one after the other. */
+        std::vector< entry > entries;                   /**< The entry for each identifier. */
+        std::vector< uint32_t > slots;                  /**< Hash table of identifiers plus one, where zero is an empty slot. */
+        int shift;                                      /**< Right shift taking a mixed fingerprint to a slot index. */
+};
+
+/**
+ * @brief Return a read only view of the elements of a stored orbit
+ * @details The view points into the store, so it is only valid until the next orbit is interned.
+ * @param [in] id - Identifier returned by intern().
+ * @return orbit_view - The view of the stored elements.
+ */
+orbit_view orbit_store::view( uint32_t id ) const
+{
+    const entry &e = entries[ id ];
+
+    return orbit_view( &keys[ e.offset ], e.code_length, e.path_length );
+}
+
+/**
+ * @brief Return the number of elements in a stored orbit
+ * @param [in] id - Identifier returned by intern().
+ * @return int - The orbital path length.
+ */
+int orbit_store::path_len( uint32_t id ) const
+{
+    return entries[ id ].path_length;
+}
+
+/**
+ * @brief Return the number of distinct orbits in the store
+ * @return size_t - The number of identifiers handed out so far.
+ */
+size_t orbit_store::size() const
+{
+    return entries.size();
+}
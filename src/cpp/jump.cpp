@@ -0,0 +1,104 @@
+/**
+ * @file jump.cpp
+ * @author Wayne Brassem (wbrassem@rogers.com)
+ * @brief Implementation of the jump table used to advance convergent orbits several downlegs at a time.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023-2026 Wayne Brassem
+ */
+
+#include <memory>
+#include "common.hpp"
+#include "jump.hpp"
+
+/**
+ * @brief Construct the jump table for every odd residue modulo 2^k
+ * @details Each odd residue r is run forward k Terras steps recording where the odd integers occur.  Since every integer
+ * congruent to r shares that parity sequence the affine map covering the steps up to the last odd integer follows directly.
+ * Writing i_0 = 0 < i_1 < ... < i_c for the positions of the odd integers, the entry covers s = i_c steps, the c downleg
+ * lengths are the gaps i_(m+1) - i_m, and the addend is 2^s * T^s(r) - 3^c * r.
+ *
+ * The drop after j steps is the smallest d with 3^(odd integers in the first j steps) * 2^d >= 2^j, and the growth of the
+ * entry is 1 + the smallest g with 2^g >= 1.5^c, which bounds each 3n+1 connection since T(n) + 1 <= 1.5 * ( n + 1 ).
+ * @param [in] k - Number of residue bits, which must be between min_bits and max_bits.
+ */
+jump_table::jump_table( int k )
+{
+    mask = ( uint64_t( 1 ) << k ) - 1;
+
+    pow3[ 0 ] = 1;
+    for ( int i = 1; i <= max_bits; i++ )
+        pow3[ i ] = 3 * pow3[ i - 1 ];
+
+    entries.resize( uint64_t( 1 ) << ( k - 1 ) );
+
+    for ( uint64_t residue = 1; residue <= mask; residue += 2 )
+    {
+        jump_entry &e = entries[ residue >> 1 ];
+
+        e.addend = 0;
+        e.leg_index = leg_list.size();
+        e.steps = e.odd = e.drop = e.growth = 0;
+
+        // The number of odd integers among the first j Terras steps
+        int odd_count[ max_bits + 1 ] = { 0 };
+
+        uint64_t t = residue;
+        int last = 0;
+
+        // Run the residue forward, recording a downleg each time another odd integer is reached.  The parity after j steps
+        // depends on the residue modulo 2^(j+1), so only odd integers reached in fewer than k steps are certain.
+        for ( int j = 1; j < k; j++ )
+        {
+            odd_count[ j ] = odd_count[ j - 1 ] + ( t & 1 );
+            t = ( t & 1 ) ? ( 3 * t + 1 ) >> 1 : t >> 1;
+
+            if ( t & 1 )
+            {
+                leg_list.push_back( j - last );
+                last = j;
+
+                e.steps = j;
+                e.odd = odd_count[ j ];
+                e.addend = ( t << j ) - pow3[ e.odd ] * residue;
+            }
+        }
+
+        // The largest drop in bit width of any intermediate integer within the steps the entry covers
+        for ( int j = 1; j <= e.steps; j++ )
+        {
+            int d = 0;
+            while ( ( pow3[ odd_count[ j ] ] << d ) < ( uint64_t( 1 ) << j ) )
+                d++;
+
+            if ( d > e.drop )
+                e.drop = d;
+        }
+
+        // Growth bound on every 3n+1 connection covered by the entry
+        int g = 0;
+        while ( ( uint64_t( 1 ) << ( g + e.odd ) ) < pow3[ e.odd ] )
+            g++;
+
+        e.growth = 1 + g;
+    }
+}
+
+/**
+ * @brief Return the cached jump table for 2^k residues, building it on first use
+ * @param [in] k - Number of residue bits.  Zero or any value outside min_bits to max_bits means jumps are disabled.
+ * @return const jump_table* - Pointer to the table or nullptr if jumps are disabled.
+ */
+const jump_table *jump_table::select( int k )
+{
+    static std::unique_ptr< jump_table > tables[ max_bits + 1 ];
+
+    if ( k < min_bits || k > max_bits )
+        return nullptr;
+
+    if ( !tables[ k ] )
+        tables[ k ] = std::make_unique< jump_table >( k );
+
+    return tables[ k ].get();
+}
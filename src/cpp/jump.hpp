@@ -0,0 +1,93 @@
+/**
+ * @file jump.hpp
+ * @author Wayne Brassem (wbrassem@rogers.com)
+ * @brief The jump_table class precomputes the affine map for k Terras steps of every odd residue modulo 2^k so that convergent
+ * orbits can be advanced several downlegs at a time
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023-2026 Wayne Brassem
+ *
+ */
+
+#pragma once
+#include "common.hpp"
+
+/**
+ * @brief A single jump table entry describing how an odd residue modulo 2^k behaves over k Terras steps
+ * @details The Terras map T(n) takes n to n/2 if n is even and to (3n+1)/2 if n is odd.  Every integer congruent to the residue
+ * modulo 2^k has the same parity sequence for the first k Terras steps.  The entry only covers the steps up to the last odd
+ * integer in that sequence so that it always ends on a complete downleg.  If the entry covers s steps with c odd integers then
+ * T^s(n) = ( 3^c * n + addend ) / 2^s exactly.
+ *
+ * The drop and growth values are used to decide whether a jump is safe without looking at the intermediate integers.  Every
+ * intermediate integer is at least n / 2^drop, and every 3n+1 connection made along the way is less than (n+1) * 2^growth.
+ */
+struct jump_entry
+{
+    public:
+        uint64_t addend;                                /**< Constant term of the affine map before the shift. */
+        uint32_t leg_index;                             /**< Index of the first downleg in the jump_table legs array. */
+        uint8_t  steps;                                 /**< Number of Terras steps (factors of 2) covered by the entry. */
+        uint8_t  odd;                                   /**< Number of 3n+1 connections (downlegs) covered by the entry. */
+        uint8_t  drop;                                  /**< Upper bound on the bits lost by any intermediate integer. */
+        uint8_t  growth;                                /**< Upper bound on the bits gained by any 3n+1 connection. */
+};
+
+/**
+ * @brief The jump_table class holds the jump_entry objects for every odd residue modulo 2^k
+ * @details Tables are built on demand by select() and kept for the life of the program.  Building the largest table with
+ * k = 20 takes a fraction of a second and about 11MB.  Only odd residues have entries because a convergent orbit is always
+ * odd between downlegs, so the table is indexed by ( n mod 2^k ) / 2.
+ */
+class jump_table
+{
+    public:
+        jump_table( int k );                            // Build the table for 2^k residues
+
+        static const jump_table *select( int k );       // Cached table for 2^k residues or nullptr if k is zero
+
+        inline const jump_entry& entry( uint64_t low_bits ) const;
+        inline const uint8_t *legs( const jump_entry &e ) const;
+        inline uint64_t power( int odd ) const;
+
+        static const int min_bits = 8;                  /**< Smallest supported number of residue bits. */
+        static const int max_bits = 20;                 /**< Largest supported number of residue bits. */
+
+    protected:
+        uint64_t mask;                                  /**< Mask selecting the residue bits k. */
+
+        std::vector< jump_entry > entries;              /**< Entries indexed by odd residue / 2. */
+        std::vector< uint8_t > leg_list;                /**< Concatenated downleg lengths of all entries. */
+        uint64_t pow3[ max_bits + 1 ];                  /**< Powers of 3 up to 3^k. */
+};
+
+/**
+ * @brief Return the entry for an odd integer given its low order bits
+ * @param [in] low_bits - The low order 64 bits of the odd integer.
+ * @return const jump_entry& - The entry for the residue of the integer modulo 2^k.
+ */
+const jump_entry& jump_table::entry( uint64_t low_bits ) const
+{
+    return entries[ ( low_bits & mask ) >> 1 ];
+}
+
+/**
+ * @brief Return the downleg lengths covered by an entry
+ * @param [in] e - An entry of this table.
+ * @return const uint8_t* - Pointer to the first of e.odd downleg lengths.
+ */
+const uint8_t *jump_table::legs( const jump_entry &e ) const
+{
+    return leg_list.data() + e.leg_index;
+}
+
+/**
+ * @brief Return the multiplier of an entry
+ * @param [in] odd - Number of 3n+1 connections covered by the entry.
+ * @return uint64_t - Returns 3^odd.
+ */
+uint64_t jump_table::power( int odd ) const
+{
+    return pow3[ odd ];
+}
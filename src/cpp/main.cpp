@@ -87,7 +87,7 @@ void longlongblowup()
 }
 
 /**
- * @brief Code to exercise the orbit_t and orbit_node_t classes. * 
+ * @brief Code to exercise the orbit_t class.
  */
 void orbit_test()
 {
@@ -0,0 +1,206 @@
+/**
+ * @file memo.cpp
+ * @author Wayne Brassem (wbrassem@rogers.com)
+ * @brief Implementation of the memory mapped table of total stopping times used to finish terminal flows by lookup.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023-2026 Wayne Brassem
+ */
+
+#include <memory>
+#include <algorithm>
+#include <thread>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "common.hpp"
+#include "memo.hpp"
+
+/**
+ * @brief Header at the start of every stop table file
+ * @details The header is written only after every entry has been generated, so a file left behind by an interrupted run is
+ * rejected and generated again.
+ */
+struct stop_header
+{
+    char magic[ 8 ];                                    /**< File signature "COLLATZ" with a terminating null. */
+    uint32_t bits;                                      /**< Number of bits k of the bound. */
+    uint32_t entry_size;                                /**< Size in bytes of each stop_entry. */
+};
+
+static const char stop_magic[ 8 ] = "COLLATZ";
+
+/**
+ * @brief Construct the table for every positive integer below 2^k
+ * @details The table file is memory mapped if it already holds a complete table for 2^k, otherwise it is generated.  If the
+ * file cannot be created the table is generated in anonymous memory instead and simply is not kept for the next run.
+ * @param [in] k - Number of bits, which must be between min_bits and max_bits.
+ */
+stop_table::stop_table( int k ) : bits( k ), limit( uint64_t( 1 ) << k ), mapping( nullptr ), entries( nullptr )
+{
+    mapped_size = sizeof( stop_header ) + limit * sizeof( stop_entry );
+
+    std::string name = "stop_table_" + std::to_string( k ) + ".bin";
+
+    if ( !map_file( name ) )
+    {
+        int fd = open( name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644 );
+
+        // Size the file and map it for writing, falling back on anonymous memory if the file is not available
+        if ( fd >= 0 && ftruncate( fd, mapped_size ) == 0 )
+            mapping = mmap( nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+
+        if ( fd < 0 || mapping == nullptr || mapping == MAP_FAILED )
+            mapping = mmap( nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+
+        if ( fd >= 0 )
+            close( fd );
+
+        if ( mapping == MAP_FAILED )
+            throw std::bad_alloc();
+
+        entries = reinterpret_cast< stop_entry * >( static_cast< char * >( mapping ) + sizeof( stop_header ) );
+        generate();
+
+        // Mark the table complete only now that every entry is in place
+        stop_header *header = static_cast< stop_header * >( mapping );
+        memcpy( header->magic, stop_magic, sizeof( stop_magic ) );
+        header->bits = k;
+        header->entry_size = sizeof( stop_entry );
+    }
+}
+
+/**
+ * @brief Destroy the table, which writes any newly generated entries back to the file
+ */
+stop_table::~stop_table()
+{
+    if ( mapping != nullptr )
+        munmap( mapping, mapped_size );
+}
+
+/**
+ * @brief Memory map an existing table file if it holds a complete table for 2^k
+ * @param [in] name - Name of the table file.
+ * @return true  - Returns true  if the file was mapped and the entries are ready for use.
+ * @return false - Returns false if the file is missing, the wrong size or incomplete.
+ */
+bool stop_table::map_file( const std::string &name )
+{
+    int fd = open( name.c_str(), O_RDONLY );
+    struct stat st;
+
+    if ( fd < 0 )
+        return false;
+
+    if ( fstat( fd, &st ) != 0 || size_t( st.st_size ) != mapped_size )
+    {
+        close( fd );
+        return false;
+    }
+
+    void *map = mmap( nullptr, mapped_size, PROT_READ, MAP_SHARED, fd, 0 );
+    close( fd );
+
+    if ( map == MAP_FAILED )
+        return false;
+
+    // Only accept a complete table built for the same bound and entry layout
+    const stop_header *header = static_cast< const stop_header * >( map );
+
+    if ( memcmp( header->magic, stop_magic, sizeof( stop_magic ) ) != 0
+        || header->bits != uint32_t( bits ) || header->entry_size != sizeof( stop_entry ) )
+    {
+        munmap( map, mapped_size );
+        return false;
+    }
+
+    mapping = map;
+    entries = reinterpret_cast< stop_entry * >( static_cast< char * >( mapping ) + sizeof( stop_header ) );
+
+    return true;
+}
+
+/**
+ * @brief Generate every entry of the table
+ * @details The integers are taken in doubling ranges [2^j, 2^(j+1)) because an orbit starting in one of them can be finished
+ * from the table as soon as it drops below 2^j.  Entries within a range never depend on one another, so each range is split
+ * into one slice per hardware thread once it is large enough to be worth it.
+ */
+void stop_table::generate()
+{
+    unsigned threads = std::max( 1u, std::thread::hardware_concurrency() );
+
+    entries[ 0 ] = { 0, 0 };
+    entries[ 1 ] = { 0, 0 };
+
+    for ( uint64_t low = 2; low < limit; low <<= 1 )
+    {
+        uint64_t slices = ( low < ( uint64_t( 1 ) << 16 ) ) ? 1 : threads;
+        uint64_t width = low / slices;
+        std::vector< std::thread > workers;
+
+        // Start a thread for each slice but the last, which is done on this thread
+        for ( uint64_t s = 0; s + 1 < slices; s++ )
+            workers.emplace_back( &stop_table::generate_range, this, low, low + s * width, low + ( s + 1 ) * width );
+
+        generate_range( low, low + ( slices - 1 ) * width, 2 * low );
+
+        for ( std::thread &worker : workers )
+            worker.join();
+    }
+}
+
+/**
+ * @brief Generate the entries for a slice of the doubling range starting at low
+ * @details Each orbit is followed one step at a time, counting a new segment every time it drops below the start of the current
+ * segment.  Once it drops below low it has just started a new segment at an integer whose entry is already in the table.
+ * @param [in] low - Start of the doubling range, every integer below which already has an entry.
+ * @param [in] first - First integer of the slice.
+ * @param [in] last - One past the last integer of the slice.
+ */
+void stop_table::generate_range( uint64_t low, uint64_t first, uint64_t last )
+{
+    for ( uint64_t n = first; n < last; n++ )
+    {
+        uint64_t curr = n, segment = n;
+        unsigned steps = 0, segments = 0;
+
+        while ( curr >= low )
+        {
+            // Every orbit below 2^max_bits stays well below 2^64 so the 3n+1 connection can not overflow
+            curr = ( curr & 1 ) ? 3 * curr + 1 : curr >> 1;
+            steps++;
+
+            if ( curr < segment )
+            {
+                segment = curr;
+                segments++;
+            }
+        }
+
+        entries[ n ].steps = steps + entries[ curr ].steps;
+        entries[ n ].segments = segments + entries[ curr ].segments;
+    }
+}
+
+/**
+ * @brief Return the cached stop table for 2^k integers, mapping or generating it on first use
+ * @param [in] k - Number of bits.  Zero or any value outside min_bits to max_bits means the table is disabled.
+ * @return const stop_table* - Pointer to the table or nullptr if the table is disabled.
+ */
+const stop_table *stop_table::select( int k )
+{
+    static std::unique_ptr< stop_table > tables[ max_bits + 1 ];
+
+    if ( k < min_bits || k > max_bits )
+        return nullptr;
+
+    if ( !tables[ k ] )
+        tables[ k ] = std::make_unique< stop_table >( k );
+
+    return tables[ k ].get();
+}
@@ -0,0 +1,83 @@
+/**
+ * @file memo.hpp
+ * @author Wayne Brassem (wbrassem@rogers.com)
+ * @brief The stop_table class holds the total stopping time and convergent segment count of every positive integer below a
+ * bound of 2^k so that terminal flows can be finished by a lookup once they drop below the bound
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023-2026 Wayne Brassem
+ *
+ */
+
+#pragma once
+#include "common.hpp"
+
+/**
+ * @brief A single stop_table entry describing the complete orbit of an integer down to the global terminus
+ * @details The total stopping time counts every 3n+1 connection and every division by 2 on the way to 1.  The segment count is
+ * the number of convergent segments chained together by the terminal flow, where each segment runs from its starting integer
+ * to the first integer below it.  Both are zero for the integer 1.
+ */
+struct stop_entry
+{
+    public:
+        uint16_t steps;                                 /**< Total stopping time, the number of steps needed to reach 1. */
+        uint16_t segments;                              /**< Number of convergent segments needed to reach 1. */
+};
+
+/**
+ * @brief The stop_table class holds the stop_entry objects for every integer below 2^k under the standard 3n+1 connection
+ * @details Tables are kept in a file named stop_table_k.bin in the working directory which is memory mapped on first use, so a
+ * table only has to be generated once and is then shared by every later run.  If the file is missing or does not hold a complete
+ * table for 2^k it is generated again by a parallel generator and saved.  The generator works through the doubling ranges
+ * [2^j, 2^(j+1)) in order, splitting each range across the hardware threads, and every orbit is only followed until it drops
+ * below the range it started in since the rest of its entry is already in the table.
+ *
+ * Each entry takes 4 bytes, so the largest table with k = 32 is 16GB.  Every orbit below 2^32 has a total stopping time under
+ * 2^16 and stays below 2^64, which bounds the range of k.
+ */
+class stop_table
+{
+    public:
+        stop_table( int k );                            // Map or generate the table for integers below 2^k
+        ~stop_table();
+
+        static const stop_table *select( int k );       // Cached table for 2^k integers or nullptr if k is zero
+
+        inline uint64_t bound() const;
+        inline const stop_entry& entry( uint64_t n ) const;
+
+        static const int min_bits = 8;                  /**< Smallest supported number of bits. */
+        static const int max_bits = 32;                 /**< Largest supported number of bits. */
+
+    protected:
+        bool map_file( const std::string &name );
+        void generate();
+        void generate_range( uint64_t low, uint64_t first, uint64_t last );
+
+        int bits;                                       /**< Number of bits k of the bound. */
+        uint64_t limit;                                 /**< Bound 2^k on the integers in the table. */
+        size_t mapped_size;                             /**< Size in bytes of the memory mapping including the header. */
+        void *mapping;                                  /**< Start of the memory mapping. */
+        stop_entry *entries;                            /**< Entries indexed by integer, following the header. */
+};
+
+/**
+ * @brief Return the bound on the integers held in the table
+ * @return uint64_t - Returns 2^k, so every integer from 1 up to 2^k - 1 has an entry.
+ */
+uint64_t stop_table::bound() const
+{
+    return limit;
+}
+
+/**
+ * @brief Return the entry for a positive integer below the bound
+ * @param [in] n - Positive integer less than bound().
+ * @return const stop_entry& - The total stopping time and segment count of n.
+ */
+const stop_entry& stop_table::entry( uint64_t n ) const
+{
+    return entries[ n ];
+}
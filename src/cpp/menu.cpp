@@ -14,7 +14,13 @@
 
 #include "common.hpp"
 #include "btree.hpp"
+#include "bplus.hpp"
+#include "histogram.hpp"
+#include "batch.hpp"
+#include "sieve.hpp"
+#include "memo.hpp"
 #include "path.cpp"
+#include "intern.hpp"
 #include "oeis.hpp"
 
 // Wrapper to prevent duplication if header included twice
@@ -33,6 +39,9 @@ int statics::memory = 0x2;
 // Speed and progress controls
 bool statics::speed = false;
 int  statics::blip_modulus = 0;
+int  statics::jump_bits = 0;
+int  statics::sieve_bits = 0;
+int  statics::memo_bits = 0;
 
 // Print control variables
 int statics::count = 0;
@@ -88,7 +97,7 @@ bool get_time_diff( const time_t end, const time_t beginning, std::string &diff_
  * The btree class accepts an optional function pointer to the btree::constForwardIterator() and btree::constReverseIterator()
  * tree iterators.
  * Likewise, the template t_btree<K> class accepts an optional function pointer to the t_btree<K>::constForwardIterator()
- * and t_btree<K>::constReverseIterator() tree iterators.
+ * and t_btree<K>::constReverseIterator() tree iterators, as do the dense_histogram and t_hist<K> histograms.
  * 
  * These arguments provide a callback function which is optionally called during tree traversals which allows for
  * the customization of the display output as the nodes are visited in the order chosen.
@@ -137,32 +146,39 @@ inline void const_body_downleg_print( const long key, const long count )
 /**
  * @brief Prints the frequency, number of downlegs and the orbit path flow.
  * @details This function is called in support of option \b l in the OEIS sub-menu which itself is called by the
- * template function \ref t_convergent_path<T>.
- * The btree and template t_btree<K> classes accept a function pointer for the forward and
- * reverse iterator member function which provides a callback function which is optionally called during tree traversals.
- * @param [in] o - The const orbit_t object containing the orbit path
+ * template function \ref t_convergent_path<T>.  The orbit is only rendered as a string here, when it is printed.
+ * @param [in] store - The orbit_store holding the orbit
+ * @param [in] id - The identifier of the orbit in the store
  * @param [in] count - The frequency of a particular orbit in the range
- * @see btree, t_btree
+ * @see orbit_store
  */
-inline void const_orbit_print( const orbit_t &o, const long count )
+inline void const_orbit_print( const orbit_store &store, uint32_t id, const long count )
 {
-    printf( "Count %*ld, downlegs %4d: flow is %s\n", statics::count, count, o.path_len(), o.path().c_str() );
+    char buffer[ orbit_view::buffer_size ];
+    std::string spill;
+
+    printf( "Count %*ld, downlegs %4d: flow is %s\n", statics::count, count, store.path_len( id ),
+            store.view( id ).text( buffer, sizeof( buffer ), spill ) );
 }
 
 /**
  * @brief Prints the frequency, path length and the orbit path flow.
  * @details This function is called in support of option \b j in the OEIS sub-menu called by \ref t_dist_path<T>.
- * The btree and template t_btree<K> classes accept a function pointer for the forward and reverse iterator
- * member function which provides a callback function which is optionally called during tree traversals.
+ * The t_hist<K> histogram accepts a function pointer for the forward and reverse iterator member function just as the
+ * t_btree<K> class does, which provides a callback function which is optionally called as the keys are visited in order.
  * @tparam P - The path object type which can be built on regular precision or multiple precision integers.
  * @param [in] p - The path object itself.
  * @param [in] count - The frequency that the path object occured in the exponent range.
- * @see btree, t_btree
+ * @see t_hist, t_btree
  */
 template < class P >
 inline void t_const_path_downleg_print( const P &p, const long count )
 {
-    printf( "Count %10ld, downlegs %4lu: flow is %s\n", count, p.pathLength(), p.getpath().c_str() );
+    char buffer[ orbit_view::buffer_size ];
+    std::string spill;
+
+    printf( "Count %10ld, downlegs %4lu: flow is %s\n", count, p.pathLength(),
+            p.orbit().view().text( buffer, sizeof( buffer ), spill ) );
 }
 
 /**
@@ -222,6 +238,77 @@ inline void make_blip( long i, long blip, long range )
     }
 }
 
+/**
+ * @brief Fill a histogram of convergent path lengths for the positive integers 1 to range using the batch engine
+ * @details This is used by \ref t_dist_legs<T> and \ref t_dist_eq<T> when nothing but the histogram is needed, which saves
+ * building a path object for every integer in the range.  Any orbit which the engine flags as overflowing is handed to
+ * path::stats() so that the overflow is reported exactly as before.
+ * @param [in] histogram - The histogram of path lengths to fill.
+ * @param [in] range - The upper limit of the range of positive integers.
+ * @param [in] show_blips - Whether or not to display progress blips.
+ * @param [in] blip - The integer spacing between successive blips.
+ * @see batch
+ */
+void batch_dist( dense_histogram &histogram, long range, bool show_blips, long blip )
+{
+    const long block = 4096;
+    std::vector< long > lengths( block );
+
+    for ( long first = 1; first <= range; first += block )
+    {
+        long count = std::min( block, range - first + 1 );
+        batch::path_lengths( first, count, lengths.data() );
+
+        for ( long j = 0; j < count; j++ )
+        {
+            long i = first + j;
+
+            // Count the legs of the integer
+            histogram.insert( lengths[ j ] >= 0 ? lengths[ j ] : path::stats( i ).path_len );
+
+            if ( show_blips )
+                make_blip( i, blip, range );
+        }
+    }
+}
+
+/**
+ * @brief Check whether the batch engine can replace path objects for a histogram of path lengths
+ * @tparam P - Path object type.  Only \ref path is supported by the batch engine.
+ * @param [in] sign - Sign of the integers in the range.
+ * @param [in] printing - Whether or not each path is printed, which needs the path object itself.
+ * @return true - The batch engine produces the same histogram.
+ * @return false - The path objects need to be built one at a time.
+ */
+template < class P >
+bool batch_dist_ok( int sign, bool printing )
+{
+    if constexpr ( std::is_same< P, path >::value )
+        return sign > 0 && !printing;
+    else
+        return false;
+}
+
+/**
+ * @brief Select the residue sieve for a scan over a range of integers if it can be used
+ * @details The sieve only holds for positive integers under the standard 3n+1 connection, and every integer is scanned anyway
+ * when the paths are printed.  The range of 3 * 2^e integers must also be a whole number of sieve blocks of 3 * 2^k.
+ * @tparam P - Path object type whose Collatz map decides whether the sieve holds.
+ * @param [in] sign - Sign of the integers in the range.
+ * @param [in] printing - Whether or not each path is printed, which needs every path object.
+ * @param [in] exponent - The exponent e of the range.
+ * @return const residue_sieve* - The sieve selected in the menu or nullptr if the whole range must be scanned.
+ * @see residue_sieve
+ */
+template < class P >
+const residue_sieve *scan_sieve( int sign, bool printing, long exponent )
+{
+    if ( sign > 0 && !printing && statics::sieve_bits <= exponent && P::map_type::standard() )
+        return residue_sieve::select( statics::sieve_bits );
+
+    return nullptr;
+}
+
 /**
  * @defgroup main_menu Main menu functions
  * @brief Group of functions responsible for displaying and implementing the main menu.
@@ -244,6 +331,12 @@ inline void make_blip( long i, long blip, long range )
  * It is also possible to enable "multiple precision" integers if you compiled with the GNU MP libraries.  This allows you to
  * process arbitrarily large integers if desired.  By default this option is off.
  * 
+ * Where the compiler furnishes native 128-bit integers they can be enabled instead.  These cover orbits which climb past
+ * 2^63 at close to the speed of the standard 64-bit integers.  By default this option is off.
+ * 
+ * The terminal flows of menu options \b c and \b g can be finished from a memo table holding the total stopping time of every
+ * integer below 2^k.  The table is generated once and kept in the working directory for later runs.  By default this option is off.
+ * 
  * @{
  */
 
@@ -342,10 +435,35 @@ inline I t_seq_eq( P p )
     return t_seq< P, I >( p, p.classFactors(), p.classLength() );
 }
 
+/**
+ * @brief Convert a positive integer below the stop table bound into a table index
+ * @tparam I - Interger object type.  Choices are built-in types (long, unit32_t, etc.) and mpz_class if compiled with GNU MP libraries.
+ * @param [in] integer - Positive integer less than stop_table::bound().
+ * @return uint64_t - The integer as an index into the stop table.
+ */
+template < class I >
+inline uint64_t memo_index( const I &integer )
+{
+    return static_cast< uint64_t >( integer );
+}
+
+#ifdef gnu_mp
+/**
+ * @brief Convert a positive multiple precision integer below the stop table bound into a table index
+ * @param [in] integer - Positive integer less than stop_table::bound().
+ * @return uint64_t - The integer as an index into the stop table.
+ */
+inline uint64_t memo_index( const mpz_class &integer )
+{
+    return integer.get_ui();
+}
+#endif // #ifdef gnu_mp
+
 /**
  * @brief Chain together convergent sequences in the quest of global terminus given an integer
  * @details This function is in support of menu option \b c. This iteratively calls upon the \ref t_seq_path<P,I>
- * (menu option \b b) so that it shows the complete convergent orbit which terminates at 1.
+ * (menu option \b b) so that it shows the complete convergent orbit which terminates at 1.  If a memo table is selected then
+ * every segment after the first which starts below its bound is replaced by a single line with the totals from the table.
  * @tparam P - Path object type.  Choices are \ref path and \ref mp_path if compiled with GNU MP libraries.
  * @tparam I - Interger object type.  Choices are built-in types (long, unit32_t, etc.) and mpz_class if compiled with GNU MP libraries.
  * @param integer - Starting integer for which to compute the convergent orbit
@@ -355,11 +473,24 @@ void t_term_path( const I &integer )
 {
     I last_int, next_int = integer;
 
+    // The stop table only holds positive integers under the standard 3n+1 connection
+    const stop_table *table = P::map_type::standard() ? stop_table::select( statics::memo_bits ) : nullptr;
+
     // Do while loop which terminates once it encounters a loop
     do
     {
         last_int = next_int;
         next_int = t_seq_path< P, I >( last_int );
+
+        // Once the flow drops below the bound of the stop table the rest of it is a lookup
+        if ( table && next_int > 1 && next_int < I( table->bound() ) )
+        {
+            const stop_entry &e = table->entry( memo_index( next_int ) );
+
+            std::cout << "Terminal flow from " << next_int << " completed from the memo table: " << e.segments
+                      << " more segments and " << e.steps << " steps to reach 1" << std::endl;
+            return;
+        }
     }
     // Continue until you find a value whose magnitude is less than you started with
     while ( abs( last_int ) > abs( next_int) );
@@ -418,16 +549,16 @@ void t_term_ec( const std::string &str )
  * provided exponent.  The range is equal to \f[ 3 \cdot 2^e \f] where e is the exponent argument.
  * 
  * The function creates a histogram by computing the number of downlegs required for convergence to a smaller integer.
- * and incrementing the counter for unique to each downleg count in a btree object.  It then displays the distibution.
+ * and incrementing the counter for unique to each downleg count in a dense_histogram object.  It then displays the distibution.
  * @tparam P - Path object type.  Choices are \ref path and \ref mp_path if compiled with GNU MP libraries.
  * @tparam I - Interger object type.  Choices are built-in types (long, unit32_t, etc.) and mpz_class if compiled with GNU MP libraries.
  * @param exponent - The range of positive integers evaluated is which 2 raised to exponent times 3 as in the formula shown.
- * @see btree
+ * @see dense_histogram
  */
 template < class P, class I >
 void t_dist_legs( long exponent )
 {
-    btree histogram;                // binary tree which grows as needed to store leg counts
+    dense_histogram histogram;      // array of counters which grows as needed to store leg counts
     
     int suppress = 12, blipexp = 14;
 
@@ -440,22 +571,33 @@ void t_dist_legs( long exponent )
     if ( exponent >= suppress )
         std::cout << "Dist legs suppression: " << suppress << " or greater" << std::endl;
 
-    // Iterate through all the odd numbers in the exponent range
-    for ( long i = 1; i <= range; ++i )
+    // When the paths are not printed only their lengths are needed, which the batch engine computes several at a time
+    if ( batch_dist_ok< P >( sign, exponent <= suppress ) )
+        batch_dist( histogram, range, exponent > blipexp, blip );
+
+    // Otherwise iterate through all the odd numbers in the exponent range
+    else
     {
-        P p( i * sign );
-        long legs = p.pathLength();
+        for ( long i = 1; i <= range; ++i )
+        {
+            // Output the path if within the suppress range, which needs the complete path object
+            if ( exponent <= suppress )
+            {
+                P p( i * sign );
 
-        // Insert node for legs or increment existing node
-        histogram.insert( legs );
+                // Count the legs of the integer
+                histogram.insert( p.pathLength() );
+                p.prettyPrintPath( base10_digits( range ) );
+            }
 
-        // If output suppression is in effect display a progress blip
-        if ( exponent > blipexp )
-            make_blip( i, blip, range );
+            // Otherwise only the path length is needed and the orbit need not be recorded
+            else
+                histogram.insert( P::stats( i * sign ).path_len );
 
-        // Otherwise output the path if within the suppress range
-        else if ( exponent <= suppress )
-            p.prettyPrintPath( base10_digits( range ) );
+            // If output suppression is in effect display a progress blip
+            if ( exponent > blipexp )
+                make_blip( i, blip, range );
+        }
     }
 
     // Counter which keeps track of the total distribution size
@@ -476,7 +618,7 @@ void t_dist_legs( long exponent )
 template < class P, class I >
 void t_dist_eq( long exponent )
 {
-    btree histogram;                    // binary tree which grows as needed to store leg counts
+    dense_histogram histogram;          // array of counters which grows as needed to store leg counts
 
     int suppress = 12, blipexp = 14;
 
@@ -489,22 +631,33 @@ void t_dist_eq( long exponent )
     if ( exponent >= suppress )
         std::cout << "Function dist_eq: Suppressing solutions for exponents " << suppress << " or greater" << std::endl;
 
-    // Loop through all of the possible integers in range
-    for ( long i = 1; i <= range; ++i )
+    // When the classes are not printed only the path lengths are needed, which the batch engine computes several at a time
+    if ( batch_dist_ok< P >( sign, exponent <= suppress ) )
+        batch_dist( histogram, range, exponent > blipexp, blip );
+
+    // Otherwise loop through all of the possible integers in range
+    else
     {
-        P p( i * sign );
-        int p_len = p.pathLength();
+        for ( long i = 1; i <= range; ++i )
+        {
+            // Output the equivalence class if within the suppress range, which needs the complete path object
+            if ( exponent <= suppress )
+            {
+                P p( i * sign );
 
-        // Insert node for legs or increment existing node
-        histogram.insert( p_len );
+                // Count the legs of the integer
+                histogram.insert( p.pathLength() );
+                p.prettyPrintClass( base10_digits( range ) );
+            }
 
-        // If output suppression is in effect display a progress blip
-        if ( exponent > blipexp )
-            make_blip( i, blip, range );
+            // Otherwise only the path length is needed and the orbit need not be recorded
+            else
+                histogram.insert( P::stats( i * sign ).path_len );
 
-        // Otherwise output the equivalence class if within the suppress range
-        else if ( exponent <= suppress )
-            p.prettyPrintClass( base10_digits( range ) );
+            // If output suppression is in effect display a progress blip
+            if ( exponent > blipexp )
+                make_blip( i, blip, range );
+        }
     }
 
     // Counter which keeps track of the total distribution size
@@ -527,7 +680,7 @@ void t_dist_eq( long exponent )
 template < class P, class I >
 void t_dist_path( long exponent )
 {
-    t_btree< P > histogram;            // Structure to efficiently compare convergent paths
+    t_hist< P > histogram;             // Hash table counting each convergent path, sorted only for output
 
     // Control output and blip settings
     int suppress = 12, blipexp = 14;
@@ -541,11 +694,17 @@ void t_dist_path( long exponent )
     if ( exponent >= suppress )
         std::cout << "Dist_path suppression: " << suppress << " or greater" << std::endl;
 
+    // Skip the integers whose pathway is fixed by their residue unless the paths are printed
+    const residue_sieve *sieve = scan_sieve< P >( sign, exponent <= suppress, exponent );
+
+    // Make sure the progress blips land on integers which are scanned
+    if ( sieve )
+        statics::blip_modulus = sieve -> survivors().front();
+
     // Iterate through all the odd numbers in the exponent range
-    for ( long i = 1; i <= range; ++i )
+    for ( long i = 1; i <= range; i = sieve ? sieve -> next( i ) : i + 1 )
     {
         P p( i * sign );
-        histogram.insert( p );
 
         // If output suppression is in effect display a progress blip
         if ( exponent > blipexp )
@@ -554,6 +713,16 @@ void t_dist_path( long exponent )
         // Otherwise output the path if within the suppress range
         else if ( exponent <= suppress )
             p.prettyPrintPath( base10_digits( range ) );
+
+        // The path is no longer needed so its orbit can be moved into the histogram
+        histogram.insert( std::move( p ) );
+    }
+
+    // Every integer of a sieved residue above the floor shares the same pathway, so add them all at once
+    if ( sieve && sieve -> members( range ) )
+    {
+        for ( long residue : sieve -> sieved() )
+            histogram.insert( P( sieve -> largest( residue, range ) ), sieve -> members( range ) );
     }
 
     histogram.constForwardIterator( &t_const_path_downleg_print< P > );
@@ -581,14 +750,8 @@ void t_convergent_eq( long digits )
     int sign = sgn( digits );     // Use the sign of the exponent to select negative integers
     digits = abs( digits );       // Once the sign has been recorded use the positive value for computation
 
-    t_btree< std::string >  string_tree_array[ digits+1 ];   // Array of binary trees of path objects with individual int counters
-    int                     string_len_counts[ digits+1 ];   // Array to hold counters of each length (aggregate multiple pathways)
-
-    // Initialize the dynamically sized array
-    for ( long i=0; i<=digits; ++i )
-    {
-        string_len_counts[ i ] = 0;
-    }
+    t_bplus< std::string >  string_tree_array[ digits+1 ];   // Array of B+-trees of path objects with individual int counters
+    dense_histogram         string_len_counts;               // Counters of each length (aggregate multiple pathways)
 
     long range = find_range( digits );
     long blip  = find_range( blipexp );
@@ -600,8 +763,15 @@ void t_convergent_eq( long digits )
 
     long found = 0;    
 
+    // Skip the integers whose equivalence class is fixed by their residue unless the classes are printed
+    const residue_sieve *sieve = scan_sieve< P >( sign, digits <= suppress, digits );
+
+    // Make sure the progress blips land on integers which are scanned
+    if ( sieve )
+        statics::blip_modulus = sieve -> survivors().front();
+
     // Loop through all of the possible integers in range
-    for ( long i = 1; i <= range; ++i )
+    for ( long i = 1; i <= range; i = sieve ? sieve -> next( i ) : i + 1 )
     {
         P p( i * sign );
 
@@ -618,11 +788,28 @@ void t_convergent_eq( long digits )
         {
             found ++;           // Increment the number of convergent paritions
 
-            t_btree< std::string > *string_tree_element = &( string_tree_array[ p.pathFactors() ] );
+            t_bplus< std::string > *string_tree_element = &( string_tree_array[ p.pathFactors() ] );
             string_tree_element -> insert( p.flow( p.pathFactors() ) );        // Insert the equivalence class representation
         }
     }
 
+    // Every integer of a sieved residue above the floor belongs to the same equivalence class, so add them all at once
+    if ( sieve && sieve -> members( range ) )
+    {
+        long members = sieve -> members( range );
+
+        for ( long residue : sieve -> sieved() )
+        {
+            P p( sieve -> largest( residue, range ) );
+
+            if ( p.pathFactors() <= digits )
+            {
+                found += members;
+                string_tree_array[ p.pathFactors() ].insert( p.flow( p.pathFactors() ), members );
+            }
+        }
+    }
+
     // Print out the header if you are going to output all of the equivalence classes
     if ( digits <= summary )
         std::cout << "\nSummary of convergent equivalence classes with up to " << digits << " digits in length " << std::endl;
@@ -633,23 +820,23 @@ void t_convergent_eq( long digits )
     {
         // Print out the classes if the number of digits in flow is less than or equal to the summary limit
         if ( digits <= summary )
-            string_len_counts[ i ] = string_tree_array[ i ].constForwardIterator( &t_ec_print< std::string > );
+            string_len_counts.insert( i, string_tree_array[ i ].constForwardIterator( &t_ec_print< std::string > ) );
         
         // Otherwise collect the counters, but suppress the output of the equivalance classes
         else
-            string_len_counts[ i ] = string_tree_array[ i ].constForwardIterator( nullptr );
+            string_len_counts.insert( i, string_tree_array[ i ].constForwardIterator( nullptr ) );
     }
 
     // Counter which keeps track of the total distribution size
-    int sum = 0;
+    long sum = 0;
 
     printf("\nClasslen (Pathways): Frequency\n");
 
     // Loop through the array of binary tree looking for case where there is at least one node in the tree
     for ( long i = 0; i <= digits; ++i )
     {
-        t_btree< std::string > *string_tree_element = &( string_tree_array[ i ] );
-        long len_counts = string_len_counts[ i ];
+        t_bplus< std::string > *string_tree_element = &( string_tree_array[ i ] );
+        long len_counts = string_len_counts.search( i );
         long nodes = string_tree_element -> nodes();
 
         // Print only if there are any nodes in tree of a given length
@@ -691,14 +878,20 @@ void t_convergent_path( long path_length )
     int sign = sgn( path_length );     // Use the sign of the exponent to select negative integers
     path_length = abs( path_length );       // Once the sign has been recorded use the positive value for computation
 
-    t_btree< orbit_t >  orbit_tree_array[ path_length+1 ];   // Array of binary trees of path objects with individual int counters
-    long                orbit_len_counts[ path_length+1 ];   // Array to hold counters of each length (aggregate multiple pathways)
+    orbit_store         store;                               // Single copy of every distinct pathway under a 32-bit identifier
+    std::vector< long > orbit_counts;                        // Frequency of each pathway indexed by its identifier
+    dense_histogram     orbit_len_counts;                    // Counters of each length (aggregate multiple pathways)
 
-    // Initialize the dynamically sized array
-    for ( long i=0; i<=path_length; ++i )
+    // Count a pathway by its identifier, which is new whenever it is one past the last identifier seen
+    auto count_orbit = [ & ]( const orbit_t &o, long members )
     {
-        orbit_len_counts[ i ] = 0;
-    }
+        uint32_t id = store.intern( o );
+
+        if ( id == orbit_counts.size() )
+            orbit_counts.push_back( 0 );
+
+        orbit_counts[ id ] += members;
+    };
 
     long range = find_range( path_length);
     long blip  = find_range( blipexp );
@@ -714,9 +907,15 @@ void t_convergent_path( long path_length )
     long start = 1, increment = 1;
     statics::blip_modulus = 0;      
 
+    // The residue sieve skips the integers whose pathway is fixed by their residue exactly, so it replaces the speed cheat
+    const residue_sieve *sieve = scan_sieve< P >( sign, path_length < suppress, path_length );
+
+    if ( sieve )
+        statics::blip_modulus = sieve -> survivors().front();
+
     // Okay, so if in speed mode cheat a bit and only target (mod 4) so i % 4 = 3 because that's where the action is
     // But serously only enable this cheat if you are working with path lengths at least as long as the blip exponent
-    if ( statics::speed && ( path_length >= blipexp ) )
+    else if ( statics::speed && ( path_length >= blipexp ) )
     {
         start = 3;
         increment = 4;
@@ -724,7 +923,7 @@ void t_convergent_path( long path_length )
     }
 
     // Loop through all of the possible integers in range
-    for ( long i = start; i <= range; i+=increment )
+    for ( long i = start; i <= range; i = sieve ? sieve -> next( i ) : i + increment )
     {
         P p( i * sign, path_length );
 
@@ -749,11 +948,30 @@ void t_convergent_path( long path_length )
         else
             p.prettyPrintPath( base10_digits( range ) );
 
-        // If the convergent path length is less than or equal to the goal (path_length) then insert into tree
+        // If the convergent path length is less than or equal to the goal (path_length) then count the pathway
         if ( p.pathFactors() <= path_length )
+            count_orbit( p.orbit(), 1 );
+    }
+
+    // Every integer of a sieved residue above the floor shares the same pathway, so add them all at once
+    if ( sieve && sieve -> members( range ) )
+    {
+        long members = sieve -> members( range );
+
+        for ( long residue : sieve -> sieved() )
         {
-            t_btree< orbit_t > *t_path_tree_element = &( orbit_tree_array[ p.pathLength() ] );
-            t_path_tree_element -> insert( p.orbit() );        // Insert the path object
+            long i = sieve -> largest( residue, range );
+            P p( i, path_length );
+
+            // The largest integer of the residue also has the largest maximum, ties going to the smallest integer as before
+            if ( p.max() > max_of_max || ( p.max() == max_of_max && i < max_terminus ) )
+            {
+                max_terminus = i;
+                max_of_max = p.max();
+            }
+
+            if ( p.pathFactors() <= path_length )
+                count_orbit( p.orbit(), members );
         }
     }
 
@@ -763,20 +981,29 @@ void t_convergent_path( long path_length )
     // int longest = base10_digits( two_count );
     // std::cout << "Path with the highest frequency with a flow of 1 is "  << two_count << " which has " << longest << " digits." << std::endl;
 
+    // Group the pathway identifiers by length and collect the counters of each length
+    std::vector< std::vector< uint32_t > > orbit_len_ids( path_length+1 );
+
+    for ( uint32_t id = 0; id < store.size(); ++id )
+    {
+        orbit_len_ids[ store.path_len( id ) ].push_back( id );
+        orbit_len_counts.insert( store.path_len( id ), orbit_counts[ id ] );
+    }
+
     if ( path_length <= summary )
+    {
         std::cout << "\nSummary of convergent paths with up to " << path_length << " factors of " << statics::divisor << std::endl;
 
-    // Process tree elements in ascending order
-    for ( int i = path_length; i >= 0; --i )
-    {
-        // Print out the actual pathways if the number of digits in flow is less than or equal to the summary limit
-        if ( path_length <= summary )
-            orbit_len_counts[ i ] = orbit_tree_array[ i ].constForwardIterator( &const_orbit_print );
-            // orbit_len_counts[ i ] = orbit_tree_array[ i ].constForwardIterator( &t_const_orbit_print );
-        
-        // Otherwise collect the counters, but suppress the output of the pathways
-        else
-            orbit_len_counts[ i ] = orbit_tree_array[ i ].constForwardIterator( nullptr );
+        // Print out the actual pathways of each length in ascending order, which is the only time they need sorting
+        for ( int i = path_length; i >= 0; --i )
+        {
+            std::vector< uint32_t > &ids = orbit_len_ids[ i ];
+
+            std::sort( ids.begin(), ids.end(), [ & ]( uint32_t a, uint32_t b ) { return store.compare( a, b ) < 0; } );
+
+            for ( uint32_t id : ids )
+                const_orbit_print( store, id, orbit_counts[ id ] );
+        }
     }
 
 
@@ -788,7 +1015,7 @@ void t_convergent_path( long path_length )
     // If in speed mode this move fakes the results which we all know it would have otherwise found honestly
     // This little cheat eliminates all even and half of the odd positive integers which convergence after one connection
     // So in effect 3/4 of uninteresting positive integer space is avoided by starting with 3 and incrementing by 4
-    if ( statics::speed )
+    if ( statics::speed && !sieve )
     {
         long freq;
         
@@ -803,14 +1030,13 @@ void t_convergent_path( long path_length )
         sum += freq;
     }
 
-    // Loop through the array of binary tree looking for case where there is at least one node in the tree
+    // Loop through the pathway lengths looking for case where there is at least one pathway of that length
     for ( long i = 0; i <= path_length; ++i )
     {
-        t_btree< orbit_t > *orbit_tree_element = &( orbit_tree_array[ i ] );
-        long len_counts = orbit_len_counts[ i ];
-        long nodes = orbit_tree_element -> nodes();
+        long len_counts = orbit_len_counts.search( i );
+        long nodes = orbit_len_ids[ i ].size();
 
-        // Print only if there are any nodes in tree of a given length
+        // Print only if there are any pathways of a given length
         if ( nodes )
             node_path_print( i, nodes, len_counts );
 
@@ -828,6 +1054,10 @@ void t_convergent_path( long path_length )
     // Print out final summary
     std::cout << "Found " << sum << " convergent paths out of " << range << " total (" << sum/3 << "/" << range/3 << 
                 ") with up to " << path_length << " factors of " << statics::divisor << std::endl;
+
+    // Long scans also report how much memory the pathway store needed
+    if ( path_length >= suppress )
+        std::cout << "Pathway store used " << store.bytes() << " bytes for " << store.size() << " distinct pathways" << std::endl;
 }
 
 /** @} */  // end of main_menu Main menu functions
@@ -1148,8 +1378,16 @@ void menu()
 #ifdef gnu_mp
     // If GNU multiple precision library is enabled create a variable to track multiple precision switch
     bool mp = false;
+
+    // Also track the adaptive precision switch which promotes individual orbits only when they overflow
+    bool adaptive = false;
 #endif // #ifdef gnu_mp
 
+#ifdef gnu_int128
+    // If native 128-bit integers are available create a variable to track the 128-bit precision switch
+    bool wide = false;
+#endif // #ifdef gnu_int128
+
     while ( input != "x" )
     {
         // Standard menu of choices
@@ -1184,9 +1422,20 @@ void menu()
 
         // If GNU multiple precision library is enabled add a menus item to toggle multiple precision
         std::cout << "p: Toggle multiple precision integers:    Current setting is " << ( mp ? "on" : "off" ) << std::endl;
+
+        // If GNU multiple precision library is enabled add a menus item to toggle adaptive precision
+        std::cout << "v: Toggle adaptive precision integers:    Current setting is " << ( adaptive ? "on" : "off" ) << std::endl;
 #endif // #ifdef gnu_mp
 
+#ifdef gnu_int128
+        // If native 128-bit integers are available add a menu item to toggle them
+        std::cout << "w: Toggle native 128-bit integers:        Current setting is " << ( wide ? "on" : "off" ) << std::endl;
+#endif // #ifdef gnu_int128
+
         std::cout << "s: Toggle execution speed optimizations:  Current setting is " << ( statics::speed ? "on" : "off" ) << std::endl;
+        std::cout << "t: Set jump table residue bits (0 = off): Current setting is " << statics::jump_bits << std::endl;
+        std::cout << "r: Set residue sieve bits (0 = off):      Current setting is " << statics::sieve_bits << std::endl;
+        std::cout << "m: Set memo table bits (0 = off):         Current setting is " << statics::memo_bits << std::endl;
 
         // This would be a good place to be able to adjust the default Collatz constants
 
@@ -1209,14 +1458,72 @@ void menu()
         {
 #ifdef gnu_mp
             case 'o':   {   mp = true;
+                            adaptive = false;
+#ifdef gnu_int128
+                            wide = false;
+#endif // #ifdef gnu_int128
                             OEIS_menu();
                             break;      // This is where you ought to call the OEIS submenu
                         }
             case 'p':   {   mp = !mp;
+                            adaptive = false;   // Only one precision switch can be on at a time
+#ifdef gnu_int128
+                            wide = false;       // Only one precision switch can be on at a time
+#endif // #ifdef gnu_int128
+                            break;
+                        }
+            case 'v':   {   adaptive = !adaptive;
+                            mp = false;         // Only one precision switch can be on at a time
+#ifdef gnu_int128
+                            wide = false;
+#endif // #ifdef gnu_int128
                             break;
                         }
 #endif // #ifdef gnu_mp
+#ifdef gnu_int128
+            case 'w':   {   wide = !wide;
+#ifdef gnu_mp
+                            mp = false;         // Only one precision switch can be on at a time
+                            adaptive = false;
+#endif // #ifdef gnu_mp
+                            break;
+                        }
+#endif // #ifdef gnu_int128
             case 's':   {   statics::speed = !statics::speed;
+                            break;
+                        }
+            case 't':   {   std::cout << "Enter jump table residue bits from " << jump_table::min_bits << " to "
+                                      << jump_table::max_bits << " or 0 to disable ";
+                            std::cin >> statics::jump_bits;
+
+                            // Anything outside the supported range disables the jump table
+                            if ( statics::jump_bits < jump_table::min_bits || statics::jump_bits > jump_table::max_bits )
+                                statics::jump_bits = 0;
+
+                            break;
+                        }
+            case 'r':   {   std::cout << "Enter residue sieve bits from " << residue_sieve::min_bits << " to "
+                                      << residue_sieve::max_bits << " or 0 to disable ";
+                            std::cin >> statics::sieve_bits;
+
+                            // Anything outside the supported range disables the sieve
+                            if ( statics::sieve_bits < residue_sieve::min_bits || statics::sieve_bits > residue_sieve::max_bits )
+                                statics::sieve_bits = 0;
+
+                            break;
+                        }
+            case 'm':   {   std::cout << "Enter memo table bits from " << stop_table::min_bits << " to "
+                                      << stop_table::max_bits << " or 0 to disable ";
+                            std::cin >> statics::memo_bits;
+
+                            // Anything outside the supported range disables the memo table
+                            if ( statics::memo_bits < stop_table::min_bits || statics::memo_bits > stop_table::max_bits )
+                                statics::memo_bits = 0;
+
+                            // Map or generate the table now rather than in the middle of the next terminal flow
+                            else
+                                stop_table::select( statics::memo_bits );
+
                             break;
                         }
             default:    {
@@ -1227,8 +1534,23 @@ void menu()
                                 // Call the the multiple precision menu function template
                                 again = t_serve_menu_selection< mp_path, mpz_class> ( ch );
 
+                            // If the adaptive precision switch is active
+                            else if ( adaptive )
+
+                                // Call the the menu function template with orbits promoted only as required
+                                again = t_serve_menu_selection< adaptive_path, mpz_class > ( ch );
+
                             else
 #endif // #ifdef gnu_mp
+#ifdef gnu_int128
+                            // If the native 128-bit switch is active
+                            if ( wide )
+
+                                // Call the the native 128-bit menu function template
+                                again = t_serve_menu_selection< path128, int128_t > ( ch );
+
+                            else
+#endif // #ifdef gnu_int128
                                 // Otherwise call the standard precision menu function template
                                 again = t_serve_menu_selection< path, long > ( ch );
                         }
@@ -3,7 +3,8 @@
  * @author Wayne Brassem (wbrassem@rogers.com)
  * @brief Implementation of the orbit templated path object.  The path object is used to probe the integer convergence patterns.
  * The path objects record the equivalence class and convergent path information.
- * The underlying orbit data structure is a union which allows for faster comparison than simple character representation
+ * The underlying orbit data structure is an array of packed unions which allows for faster comparison than simple character
+ * representation
  * @version 1.1
  * @date 2025-12-20
  * 
@@ -14,152 +15,12 @@
 // This include brings in the basic definitions
 #include "path.hpp"
 #include <stdexcept>
+#include <cstring>
+#include <algorithm>
+#include <charconv>
+#include <new>
 
 
-// orbit_node_t implementations
-
-/**
- * @brief Default constructor for a new orbit_node_t::orbit_node_t object
- * @details Sets the 64-bit unsigned integer representation to 0 - which also zeroes out the 8-bit uint array elements.
- * Also initializes the pointer to the next union structure to the nullptr.
- */
-orbit_node_t::orbit_node_t()
-{
-    // Clear all state in initial node
-    init();
-};
-
-/**
- * @brief Copy constructor for a new orbit_node_t::orbit_node_t object
- * @details Copies the orbit - including all linked unions - into a new orbit_node_t orbit.  Member function calls the assignment
- * operator=() which performs the same function.
- * @param [in] ro - Const reference to the orbit to copy from.
- */
-orbit_node_t::orbit_node_t( const orbit_node_t &ro )
-{
-    // Call the assignment operator
-    operator=( ro );
-};
-
-/**
- * @brief Assignment operator
- * @details This implementation copies the contents from one linked list node into this node. Note that this implementation is
- * \b not responsible to free any existing linked list allocations - this is the reponsibility of the orbit_t struct object.
- * @param [in] ro - Const reference to the orbit to copy from.
- * @return orbit_node_t& - Returns a reference to this object so that assignment operations can be chained together if desired.
- */
-orbit_node_t &orbit_node_t::operator = ( const orbit_node_t &ro )
-{
-    // Copy the orbit segment as long integer (fastest)
-    key.i_key = ro.key.i_key;
-
-    return *this;
-};
-
-/**
- * @brief Ordinal equivalency operator
- * @details This implementation utilizes the 64-bit unsigned integer representation for performing comparisons.
- * When not equivalent for an orbit_node_t node element then this function returns false immediately.
- * If equivalent, it checks to see if both orbits have pointers to the next elements in the orbit and if so recursively
- * follows both links until either a difference is found (false) or else equivalency is established (true) since neither
- * orbit has a link to another orbit_node_t struct \b and the 64-bit integers are equivalent.
- * @param [in] ro - Const reference to the orbit to compare to.
- * @return true - The orbit consists of equivalent elements
- * @return false - The orbit does not consist of equivalent elements
- */
-bool orbit_node_t::operator == ( const orbit_node_t &ro ) const
-{
-    // Is it equivalent comparing the 64-bit integer representation?
-    if ( key.i_key == ro.key.i_key )
-    {
-        orbit_node_t *lop = next;
-        orbit_node_t *rop = ro.next;
-
-        // If there is more keep going through the list recursively
-        if ( lop && rop )
-            return *lop == *rop;
-
-        // Otherwise they are indeed equivalent orbits
-        else
-            return true;
-    }
-
-    return false;
-}
-
-/**
- * @brief Determines if this orbit is mathematically less than another
- * @details This implementation utilizes the 64-bit unsigned integer representation for performing comparisons.
- * When not equivalent for an orbit_node_t node element, it returns the less than (<) direct comparison of the 64-bit integers.
- * If equivalent, it checks to see if both orbits have pointers to the next elements in the orbit and if so recursively
- * follows both links until either a difference is found (in which case a (<) direct comparison is performed), or else equivalency
- * is established (false) since neither orbit has a link to another orbit_node_t struct \b and the 64-bit integers are equivalent.
- * @param [in] ro - Const reference to the orbit to compare to.
- * @return true - Returns true if this orbit is less than the one provided.
- * @return false - Returns false if this orbit is greater than or equal to the one provided.
- */
-bool orbit_node_t::operator < ( const orbit_node_t &ro ) const
-{
-    // Is it equivalent comparing the 64-bit integer representation?
-    if ( key.i_key == ro.key.i_key )
-    {
-        orbit_node_t *lop = next;
-        orbit_node_t *rop = ro.next;
-
-        // If there is more keep going through the list recursively
-        if ( lop && rop )
-            return *lop < *rop;
-
-        // Otherwise they are indeed equivalent orbits
-        else
-            return false;
-    }
-
-    return key.i_key < ro.key.i_key;
-}
-
-/**
- * @brief Determines if this orbit is mathematically greater than another
- * @details This implementation utilizes the 64-bit integer unsigned representation for performing comparisons.
- * When not equivalent for an orbit_node_t node element, it returns the less than (>) direct comparison of the 64-bit integers.
- * If equivalent, it checks to see if both orbits have pointers to the next elements in the orbit and if so recursively
- * follows both links until either a difference is found (in which case a (>) direct comparison is performed), or else equivalency
- * is established (false) since neither orbit has a link to another orbit_node_t struct \b and the 64-bit integers are equivalent.
- * @param [in] ro - Const reference to the orbit to compare to.
- * @return true - Returns true if this orbit is greater than the one provided.
- * @return false - Returns false if this orbit is less than or equal to the one provided.
- */
-bool orbit_node_t::operator > ( const orbit_node_t &ro ) const
-{
-    // Is it equivalent comparing the 64-bit integer representation?
-    if ( key.i_key == ro.key.i_key )
-    {
-        orbit_node_t *lop = next;
-        orbit_node_t *rop = ro.next;
-
-        // If there is more keep going through the list recursively
-        if ( lop && rop )
-            return *lop > *rop;
-
-        // Otherwise they are indeed equivalent orbits
-        else
-            return false;
-    }
-
-    return key.i_key > ro.key.i_key;
-}
-
-/**
- * @brief Initialzes the struct member to known initial values of enpty key (0) and null pointer to next orbit_key_t.
- * @details Typically this member function would be protected, but it's public to allow orbit_t objects to call it.
- */
-void orbit_node_t::init()
-{
-    // Clear all state in initial node
-    key.i_key = 0;
-    next = nullptr;
-}
-
 // struct orbit_t implentations
 
 /**
@@ -174,8 +35,8 @@ orbit_t::orbit_t()
 
 /**
  * @brief Copy constructor for a new orbit_t::orbit_t object
- * @details First calls the init() function to initalize local variables followed by copy_list() to dunplicate the linked list.
- * @param [in] ro - Objec to copy from which may include information in links lists
+ * @details First calls the init() function to initalize local variables followed by copy_list() to duplicate the unions.
+ * @param [in] ro - Object to copy from which may hold its unions on the heap
  */
 orbit_t::orbit_t( const orbit_t &ro )
 {
@@ -186,9 +47,24 @@ orbit_t::orbit_t( const orbit_t &ro )
     copy_list( ro );
 };
 
+/**
+ * @brief Move constructor for a new orbit_t::orbit_t object
+ * @details Takes over the heap or arena array of the other orbit if it has one, otherwise copies its inline unions.  The other
+ * orbit is left empty.
+ * @param [in] ro - Object to move from
+ */
+orbit_t::orbit_t( orbit_t &&ro ) noexcept
+{
+    // Clear all state
+    init();
+
+    // Take over the list contents
+    move_list( ro );
+};
+
 /**
  * @brief Destroys the orbit_t::orbit_t object
- * @details Calls the free_list() member function to deallocate any nodes allocated from the heap via the \b new operator.
+ * @details Calls the free_list() member function to deallocate the heap array if the orbit outgrew the inline unions.
  */
 orbit_t::~orbit_t()
 {
@@ -198,79 +74,84 @@ orbit_t::~orbit_t()
 
 /**
  * @brief Retrieves the orbital path as a std::string object (e.g. "0 1 2 1 2 1 3")
- * @details Decodes the binary orbit information stored in the linked list and creates a std::string representation.
+ * @details Decodes the binary orbit information stored in the unions and creates a std::string representation.  Printers which
+ * are called once per orbit should use format() instead, which does not allocate.
  * @return std::string 
  */
 std::string orbit_t::path() const
 {
-    std::string path_str;
-    const orbit_node_t *curr = nullptr;
-
-    // Create a string output for every leg of the orbital path
-    for ( int i = 0; i < path_length; ++i )
-    {
-        long pos = i % sizeof( orbit_key_t );
-
-        // Whenever you are at the beginning of a union position the pointer appropriately
-        if ( pos == 0 )
-        {
-            // If already pointing to a union go to the next
-            if ( curr )
-                curr = curr->next;
-            
-            // Otherwise you are starting from the first union in the list
-            else
-                curr = &root;
-        }
+    return view().str();
+}
 
-        // Append an integer to the path representing the number of divisor factors, then add a space as a separator
-        path_str += std::to_string(curr->key.c_key[orbit_index(pos)]) + ' ';
-    }
+/**
+ * @brief Return a read only view of the orbit elements
+ * @return orbit_view - The view, which is valid until the orbit is next changed.
+ */
+orbit_view orbit_t::view() const
+{
+    return orbit_view( keys, code_length, path_length );
+}
 
-    // remove the trailing space
-    path_str.pop_back();
+/**
+ * @brief Return an orbit element
+ * @param [in] index - The position of the element, which must be less than path_len().
+ * @return long - The element, which is the number of divisor factors of 2 following that connection.
+ * @see orbit_view::operator[]
+ */
+long orbit_t::operator [] ( int index ) const
+{
+    return view()[ index ];
+}
 
-    return path_str;
+/**
+ * @brief Write the orbital path into a caller supplied buffer without allocating
+ * @param [in] buffer - The buffer, which may be nullptr if size is zero.
+ * @param [in] size - The size of the buffer in characters.
+ * @return size_t - The length of the whole orbital path.
+ * @see orbit_view::format()
+ */
+size_t orbit_t::format( char *buffer, size_t size ) const
+{
+    return view().format( buffer, size );
 }
 
 /**
  * @brief Append a numerical path element to the sequence and store in the orbit object
- * @details Since there is a maximum of 8 unsigned 8-bit integers in each orbit_key_t union this member function first
- * determines whether or not there is any available space left in the current orbit_node_t.  If not, it allocates and links
- * a new one before storing the power of two into the linked list.
+ * @details An element less than the escape code takes a single code, and any larger element takes the escape code, a code holding
+ * its number of digits and then its digits.  If the codes would run past every union available the storage is grown before
+ * storing them.
  * @param [in] divisors - The const power of 2 exponent which can be factored after a Collatz 3n+1 connection.
  */
 void orbit_t::append( const long divisors )
 {
-    // Ensure that the number of divisors fits in an 8-bit unsigned integer
-    if (divisors < 0 || divisors > 255) {
-        throw std::logic_error("Divisors exceed 8-bit bounds; adjust integer type.");
+    // Ensure that the number of divisors fits in the largest escaped element
+    if ( divisors < 0 || ( divisors >> ( code_bits * max_digits ) ) != 0 ) {
+        throw std::logic_error( "Divisors exceed the range of an orbit element." );
     }
 
-    // Calculate the position within the orbit to append the divisors
-    long pos = path_length % sizeof( orbit_key_t );
+    // Calculate the number of codes needed and the union holding the last of them
+    int digits = ( std::bit_width( uint64_t( divisors ) ) + code_bits - 1 ) / code_bits;
+    int codes = ( divisors < escape ) ? 1 : 2 + digits;
+    int word = ( code_length + codes - 1 ) / word_codes;
 
-    // If overrun of any given union then link another one
-    if ( pos == 0 )
+    // If overrun of all the unions available then double the storage
+    if ( word >= capacity && !reserve( std::max( 2 * capacity, word + 1 ) ) )
+        return;
+
+    // Store the element as a single code or as an escape code followed by its number of digits and the digits
+    if ( divisors < escape )
+        put_code( divisors );
+    else
     {
-        // If another node needs to be allocated and linked to the list
-        if ( pos < path_length )
-        {
-            // If unable to allocate memory for new then exit
-            if ( !(curr -> next = new_node()) ) {
-                error_mask |= statics::memory;
-                return;
-            }
+        put_code( escape );
+        put_code( digits );
 
-            // Move current node pointer to the new node
-            curr = curr -> next;
-        }
+        for ( int d = digits - 1; d >= 0; --d )
+            put_code( ( divisors >> ( code_bits * d ) ) & escape );
     }
 
-    // Store the divisors at the correct physical index depending on endianness
-    curr->key.c_key[orbit_index(pos)] = static_cast<uint8_t>(divisors);
-
-    // Increment the path length
+    // Fold the element into the fingerprint and increment the path length
+    hash_key = ( std::rotl( hash_key, 5 ) ^ uint64_t( divisors ) ) * 0x100000001b3;
     path_length++;
 }
 
@@ -294,64 +175,88 @@ int orbit_t::path_len() const
     return path_length;
 }
 
+/**
+ * @brief Return the fingerprint of the orbit
+ * @details The fingerprint is updated by every append, so it costs nothing to read.  Equal orbits always have equal
+ * fingerprints, while different orbits of the same length almost never do.
+ * @return uint64_t - The 64-bit fingerprint of the orbit elements.
+ */
+uint64_t orbit_t::fingerprint() const
+{
+    return hash_key;
+}
+
 /**
  * @brief Assignment operator
- * @details The assignment operator must first elegantly handle the case were it already has a linked list which includes nodes
- * which were allocated from the heap.  It first frees any allocated nodes and reinitialized the object variables.
- * @param [in] ro - Reference to a const linked list orbit_t object to replicate including copying the key values of all linked nodes.
+ * @details The existing unions are reused when there are enough of them, otherwise the heap array is replaced by one just large
+ * enough for the orbit being copied.
+ * @param [in] ro - Reference to a const orbit_t object to replicate including copying the key values of all unions.
  * @return orbit_t& - Return a reference to the new orbit to allow for chaining assignment operations
  */
 orbit_t &orbit_t::operator = ( const orbit_t &ro )
 {
-    // Free any allocated memory from additional union nodes
-    free_list();
+    // Guard against self assignment which would otherwise free the unions being copied
+    if ( this != &ro )
+        copy_list( ro );
 
-    // Initialize the root member
-    root.init();
+    return *this;
+}
 
-    // Copy the state from ro orbt_t to this
-    root = ro.root;
-    curr = &root;
+/**
+ * @brief Move assignment operator
+ * @details Frees any heap array of this orbit and then takes over the unions of the other orbit, which is left empty.
+ * @param [in] ro - Reference to the orbit_t object to move from.
+ * @return orbit_t& - Return a reference to the new orbit to allow for chaining assignment operations
+ */
+orbit_t &orbit_t::operator = ( orbit_t &&ro ) noexcept
+{
+    // Guard against self assignment which would otherwise free the unions being moved
+    if ( this != &ro )
+    {
+        free_list();
+        init();
+        move_list( ro );
+    }
 
-    // Copy the list elements to a new linked list
-    copy_list( ro );
     return *this;
 }
 
 /**
  * @brief Ordinal equivalency operator
- * @details The equivalency operator relies on the orbit_node_t equivalency operator
+ * @details Orbits of different lengths or with different fingerprints are told apart without looking at their unions, otherwise
+ * the unions in use are compared as a block of memory.
  * @param [in] ro - Const reference to the orbit to compare to.
  * @return true - The orbits are identical.
  * @return false - The orbits are not identical.
  */
 bool orbit_t::operator == ( const orbit_t &ro ) const
 {
-    return root == ro.root;
+    if ( path_length != ro.path_length || code_length != ro.code_length || hash_key != ro.hash_key )
+        return false;
+
+    return std::memcmp( keys, ro.keys, words() * sizeof( orbit_key_t ) ) == 0;
 }
 
 /**
  * @brief Determines if this orbit is mathematically less than another
- * @details The less than (<) operator relies on the orbit_node_t less than (<) operator
  * @param [in] ro - Const reference to the orbit to compare to.
  * @return true - Returns true if this orbit is less than the one provided.
  * @return false - Returns false if this orbit is greater than or equal to the one provided.
  */
 bool orbit_t::operator < ( const orbit_t &ro ) const
 {
-    return root < ro.root;
+    return compare( ro ) < 0;
 }
 
 /**
  * @brief Determines if this orbit is mathematically greater than another
- * @details The greater than (>) operator relies on the orbit_node_t greater than (>) operator
  * @param [in] ro - Const reference to the orbit to compare to.
  * @return true - Returns true if this orbit is greater than the one provided.
  * @return false - Returns false if this orbit is less than or equal to the one provided.
  */
 bool orbit_t::operator > ( const orbit_t &ro ) const
 {
-    return root > ro.root;
+    return compare( ro ) > 0;
 }
 
 /**
@@ -364,227 +269,573 @@ void orbit_t::clear()
 }
 
 /**
- * @brief Creates a new linked list node
- * @details The menber function attempts to allocate a new orbit_node_t object from the heap.  If a failure occurs in memory
- * allocation, it prints an error to stdout and sets the memory allocation failure mask bit.  Otherwise, it returns a pointer
- * to the newly allocated node.
- * @return orbit_node_t* - A pointer to the new node (if successful), or nullptr if memory allocation failed.
+ * @brief Return the number of unions holding the orbit
+ * @return int - The number of unions in use, which is at least one even for an empty orbit.
  */
-orbit_node_t *orbit_t::new_node()
+int orbit_t::words() const
 {
-    // Allocate new node object for additional orbit storage space
-    orbit_node_t *next = new orbit_node_t;
-
-    // Check to see if memory allocated correctly
-    if ( !next )
-    {
-        std::cout << "Error: Memory allocation error" << std::endl; 
-        error_mask |= statics::memory;     // Maybe restore the error thing afterwards
-    }
+    return code_length ? ( code_length + word_codes - 1 ) / word_codes : 1;
+}
 
-    return next;
+/**
+ * @brief Return an element code
+ * @param [in] index - The position of the code in the orbit, which must be less than the number of codes in use.
+ * @return int - The 4-bit code.
+ */
+int orbit_t::code( int index ) const
+{
+    return code( keys, index );
 }
 
 /**
- * @brief Copies a linked list
- * @details Copies the orbit_key_t values which contain the path information into the local root node and allocates additional
- * nodes as required to copy any linked node key values.
- * @param [in] ro - Const reference to the linked list to replicate.
+ * @brief Return an element code from an array of unions
+ * @param [in] keys - The unions holding the codes.
+ * @param [in] index - The position of the code in the array.
+ * @return int - The 4-bit code.
  */
-void orbit_t::copy_list( const orbit_t &ro )
+int orbit_t::code( const orbit_key_t *keys, int index )
 {
-    orbit_node_t *source = ro.root.next;
+    int shift = 64 - code_bits * ( 1 + index % word_codes );
 
-    // Copy the path length and error mask
-    path_length = ro.path_length;
-    error_mask = ro.error_mask;
-    
-    // Copy the root orbit as a long integer
-    root.key.i_key = ro.root.key.i_key;
+    return ( keys[ index / word_codes ].i_key >> shift ) & escape;
+}
 
-    // Keep looping so long as there is another union in the list
-    while ( source )
-    {
-        // Create a new node to accept the orbit
-        if ( !( curr -> next = new_node() ) ) {
-            error_mask |= statics::memory;
-            return;
-        }
+/**
+ * @brief Return the element at the iterator
+ * @return long - The element, decoded from the escape code and its digits if it needed them.
+ */
+long orbit_view::const_iterator::operator * () const
+{
+    long divisors = orbit_t::code( keys, position );
 
-        // Position on the new node(s)
-        curr = curr->next;
+    // An escape code is followed by the number of digits of the element and then the digits
+    if ( divisors == orbit_t::escape )
+    {
+        int digits = orbit_t::code( keys, position + 1 );
 
-        // Copy the orbit as a long integer
-        curr->key.i_key = source->key.i_key;
+        divisors = 0;
 
-        // Move to the next orbit object if there is one
-        source = source->next;
+        for ( int i = position + 2; i < position + 2 + digits; ++i )
+            divisors = ( divisors << orbit_t::code_bits ) | orbit_t::code( keys, i );
     }
-};
+
+    return divisors;
+}
 
 /**
- * @brief Frees up any allocated nodes in the linked list
- * @details Deallocaes any orbit_node_t objects allocated from the heap.  Deallocation is necessary whenever there is an assignement
- * operation since it may already have existing heap allocations and when the orbit_t object is destructed.
+ * @brief Advance the iterator to the next element
+ * @return const_iterator& - The iterator, now at the next element.
  */
-void orbit_t::free_list()
+orbit_view::const_iterator &orbit_view::const_iterator::operator ++ ()
 {
-    orbit_node_t *next_union = root.next;
+    // Step over the escape code, digit count and digits of a large element
+    if ( orbit_t::code( keys, position ) == orbit_t::escape )
+        position += 2 + orbit_t::code( keys, position + 1 );
+    else
+        position++;
 
-    // Loop until you've deleted them all
-    while ( next_union )
-    {
-        orbit_node_t *curr = next_union;
-        next_union = next_union -> next;
-        delete curr;
-    }
-};
+    return *this;
+}
 
 /**
- * @brief Initializes the object variables
- * @details The current node pointer keeps track of the orbit_node_t object to write to.  Initially the object available for
- * writing to is the stack allocated root member so the current node is set to the address of the root node.
+ * @brief Advance the iterator to the next element
+ * @return const_iterator - A copy of the iterator before it was advanced.
  */
-void orbit_t::init()
+orbit_view::const_iterator orbit_view::const_iterator::operator ++ ( int )
 {
-    // Clear all state in initial node
-    path_length = error_mask = 0;
+    const_iterator before = *this;
 
-    // Set the root node integer key to 0 and the next pointer to nullptr
-    root.key.i_key = 0;
-    root.next = nullptr;
+    ++*this;
 
-    // Set the pointer to the root node
-    curr = &root;
-};
+    return before;
+}
 
-// Template class implementation for the path class variants
+/**
+ * @brief Return an iterator at the first element
+ * @return const_iterator - The iterator, which equals end() for an empty orbit.
+ */
+orbit_view::const_iterator orbit_view::begin() const
+{
+    return const_iterator( keys, 0 );
+}
 
-// Template t_path constructors
+/**
+ * @brief Return an iterator one past the last element
+ * @return const_iterator - The end iterator.
+ */
+orbit_view::const_iterator orbit_view::end() const
+{
+    return const_iterator( keys, code_length );
+}
 
 /**
- * @brief Default constructor for a new t_path< P >::t_path object
- * @details Calls the init() member function to initialize the member variables.
- * @tparam P - The integer data type.
+ * @brief Return the number of elements in the view
+ * @return int - The orbital path length.
  */
-template < class P >
-t_path< P >::t_path()
+int orbit_view::size() const
 {
-    init();
+    return path_length;
 }
 
 /**
- * @brief Constructor for a new t_path< P >::t_path object given an integer
- * @details Calculates the path for the provided integer and determines it's nominal equivalence class.
- * @tparam P - The integer data type.
- * @param [in] start - The starting integer of the template type - or one which has a defined conversion to the template type.
+ * @brief Check whether the view has no elements
+ * @return true  - Returns true  if the orbit is empty.
+ * @return false - Returns false if the orbit has at least one element.
  */
-template < class P >
-t_path< P >::t_path( const P &start )
+bool orbit_view::empty() const
 {
-    operator=( start );
+    return path_length == 0;
 }
 
 /**
- * @brief Constructor for a new t_path< P >::t_path object given an integer and an equivalence class length
- * @details Calculates the path for the provided integer and assigns it to its specified equivalence class length.
- * @tparam P - The integer data type.
- * @param [in] start - The const starting integer of the template type - or one which has a defined conversion to the template type.
- * @param [in] class_len - The specified equivalence class length.
+ * @brief Return an element of the view
+ * @details When no element needed an escape code every element is a single code, so the element is read directly.  Otherwise the
+ * elements are stepped over from the start.
+ * @param [in] index - The position of the element, which must be less than size().
+ * @return long - The element.
  */
-template < class P >
-t_path< P >::t_path( const P &start, long class_len )
+long orbit_view::operator [] ( int index ) const
 {
-    setpath( start, class_len );
+    if ( code_length == path_length )
+        return orbit_t::code( keys, index );
 
-    // Check for negative values and assign
-    ec_len = ( class_len < 0 ) ? 0 : class_len;
+    return *std::next( begin(), index );
 }
 
 /**
- * @brief Constructor for a new t_path< P >::t_path object given its equivalence class string representation
- * @details Parses the equivalence class to extract the leading integer from the class.
- * @tparam P - The integer data type.
- * @param [in] input - Const reference to an equivalence class std::string representation.
+ * @brief Write the elements separated by spaces into a caller supplied buffer (e.g. "0 1 2 1 2 1 3")
+ * @details The buffer is filled in the manner of snprintf.  At most size - 1 characters are written followed by a terminating
+ * null, and the returned length is that of the whole text, so a return value of size or more means the text was truncated.
+ * Nothing is allocated, which is what makes this suitable for printing millions of orbits.
+ * @param [in] buffer - The buffer, which may be nullptr if size is zero.
+ * @param [in] size - The size of the buffer in characters.
+ * @return size_t - The length of the whole text, not counting the terminating null.
  */
-template < class P >
-t_path< P >::t_path( const std::string &input )
+size_t orbit_view::format( char *buffer, size_t size ) const
 {
-    // Parse the input string to come up with an integer representation which can then be used to create to the object
-    P val = parse( input );
+    size_t length = 0;
 
-    setpath( val );
-    ec_len = get_ec_len( input );
+    for ( long divisors : *this )
+    {
+        char digits[ 24 ];
+        char *last = std::to_chars( digits, digits + sizeof( digits ), divisors ).ptr;
+
+        // Separate the elements with a single space
+        if ( length > 0 && ++length < size )
+            buffer[ length - 1 ] = ' ';
+
+        for ( const char *d = digits; d < last; ++d )
+            if ( ++length < size )
+                buffer[ length - 1 ] = *d;
+    }
+
+    // Terminate the text even if it was truncated
+    if ( size > 0 )
+        buffer[ std::min( length, size - 1 ) ] = '\0';
+
+    return length;
 }
 
 /**
- * @brief Constructor for a new t_path< P >::t_path object given its equivalence class character array representation
- * @details Parses the equivalence class to extract the leading integer from the class.
- * @tparam P - The integer data type.
- * @param [in] input - Const reference to an equivalence class character array representation.
+ * @brief Return the text of the elements for printing, using the caller supplied buffer whenever it is large enough
+ * @details Only an orbit whose text does not fit in the buffer is formatted into the spill string instead, so a stack buffer of
+ * buffer_size characters avoids allocating for all but unusually long orbits.
+ * @param [in] buffer - The buffer.
+ * @param [in] size - The size of the buffer in characters.
+ * @param [in,out] spill - String which holds the text if it does not fit in the buffer.
+ * @return const char* - The null terminated text, in either the buffer or the spill string.
  */
-template < class P >
-t_path< P >::t_path( const char input[] )
+const char *orbit_view::text( char *buffer, size_t size, std::string &spill ) const
 {
-    // Parse the characters array to come up with an integer representation which can then be used to create to the object
-    P val = parse( input );
+    if ( format( buffer, size ) < size )
+        return buffer;
 
-    setpath( val );
-    ec_len = get_ec_len( input );
+    spill = str();
+
+    return spill.c_str();
 }
 
 /**
- * @brief Destructor for the t_path< P >::t_path object
- * @details Currently just zeroes out all values and as such is likely not strictly necessary.
- * @tparam P - The integer data type.
+ * @brief Return the elements separated by spaces as a std::string object (e.g. "0 1 2 1 2 1 3")
+ * @return std::string - The text of the elements.
  */
-template < class P >
-t_path< P >::~t_path()
+std::string orbit_view::str() const
 {
-    zeroize();
+    std::string path_str( format( nullptr, 0 ), ' ' );
+
+    format( path_str.data(), path_str.size() + 1 );
+
+    return path_str;
 }
 
 /**
- * @brief Set the value for path object (deletes existing state first)
- * @details This member function does quite a bit.  It is called by t_path<> constrcutors or directly for existing objects.
- * It first established the integer starting point for convergence and then calculates the entire oribital path needed to
- * be able to converge to a smaller integer.  This keep track of the total number of factors of 2 used in convergence as well
- * as the number of divergent 3n+1 connections.  The main loop exits once the new integer in the orbit is no longer greater
- * that the starting integer.  This means it also exists upon equivalency which is needed as the termination condition at the
- * global terminus of 1.  Finally it initialize the number of factors of 2 in the equivalence class (which is greatet than
- * or equal to the path factors) and looks ahead to see the number of factors of 2 after then ext 3n+1 connections.
- * @tparam P - The integer data type.
- * @param [in] start - The initial integer that you need to search for a convergent flow for.
- * @param [in] max_factors - Optional upper limit on the number of factors of 2 in the path (defaults to zero).
+ * @brief Store the next element code
+ * @details A union is cleared as it comes into use so that the unused codes compare as zero.  The caller must already have made
+ * room for the code.
+ * @param [in] value - The 4-bit code to store.
  */
-template < class P >
-void t_path< P >::setpath( const P &start, int max_factors )
+void orbit_t::put_code( int value )
 {
-    // Clear any existing state and initialize to the start value
-    init( start );
+    int word = code_length / word_codes;
+    int pos = code_length % word_codes;
 
-    // Set the current and maximum integer in orbit to starting integer
-    P current_int = start;
-    max_int = start;
+    if ( pos == 0 )
+        keys[ word ].i_key = 0;
 
-    // orbit_node_t *curr_orb = nullptr;
+    keys[ word ].i_key |= uint64_t( value ) << ( 64 - code_bits * ( 1 + pos ) );
 
-    // Eliminate the even numbers first, they converge immediately
-    if ( start % statics::divisor == 0 )
+    code_length++;
+}
+
+/**
+ * @brief Compare two orbits one 64-bit union at a time
+ * @details See the static compare() which does the work.
+ * @param [in] ro - Const reference to the orbit to compare to.
+ * @return int - Negative, zero or positive if this orbit is less than, equal to or greater than the one provided.
+ */
+int orbit_t::compare( const orbit_t &ro ) const
+{
+    return compare( keys, code_length, path_length, ro.keys, ro.code_length, ro.path_length );
+}
+
+/**
+ * @brief Compare two orbits held in arrays of unions
+ * @details The unions are compared in a single loop using their 64-bit unsigned integer representation, and the first
+ * difference decides.  Since the codes are packed from the most significant bits this orders the orbits lexicographically by
+ * their elements.  If the orbits agree on all the unions they have in common then one is a prefix of the other, and the path
+ * length breaks the tie so that the shorter orbit comes first and only identical orbits compare as equal.
+ * @param [in] a - The unions of the first orbit.
+ * @param [in] a_codes - The number of codes in use by the first orbit.
+ * @param [in] a_length - The path length of the first orbit.
+ * @param [in] b - The unions of the second orbit.
+ * @param [in] b_codes - The number of codes in use by the second orbit.
+ * @param [in] b_length - The path length of the second orbit.
+ * @return int - Negative, zero or positive if the first orbit is less than, equal to or greater than the second.
+ */
+int orbit_t::compare( const orbit_key_t *a, int a_codes, int a_length, const orbit_key_t *b, int b_codes, int b_length )
+{
+    int common = ( std::min( a_codes, b_codes ) + word_codes - 1 ) / word_codes;
+
+    for ( int i = 0; i < common; ++i )
     {
-        // All numbers which divide evenly by the divisor converge locally with a minimum of a single factor of the divisor
-        orb.append( 1 );
-        path_factors++;
+        if ( a[ i ].i_key != b[ i ].i_key )
+            return a[ i ].i_key < b[ i ].i_key ? -1 : 1;
     }
-    
-    // Otherwise its odd, diverges and you need to figure out how it converges
-    else
-    {
-        // All other paths begin with 0 since they cannot be divided evenly by the divisor
-        orb.append( 0 );
 
-        // Loop until you find a smaller magnitude
-        do
+    return ( a_length > b_length ) - ( a_length < b_length );
+}
+
+/**
+ * @brief Make room for at least count unions
+ * @details The unions in use are moved into a new array if there are not already enough of them available.  The array comes from
+ * the current arena if there is one and from the heap otherwise.  If a failure occurs in heap allocation, it prints an error to
+ * stdout and sets the memory allocation failure mask bit.
+ * @param [in] count - The number of unions needed.
+ * @return true - There is room for count unions.
+ * @return false - Memory allocation failed and the orbit is unchanged.
+ */
+bool orbit_t::reserve( int count )
+{
+    if ( count <= capacity )
+        return true;
+
+    // Allocate a new array for additional orbit storage space from the current arena if there is one, otherwise the heap
+    arena *pool = arena::current();
+    orbit_key_t *grown = pool ? static_cast< orbit_key_t * >( pool->allocate( count * sizeof( orbit_key_t ), alignof( orbit_key_t ) ) )
+                              : new ( std::nothrow ) orbit_key_t[ count ];
+
+    // Check to see if memory allocated correctly
+    if ( !grown )
+    {
+        std::cout << "Error: Memory allocation error" << std::endl; 
+        error_mask |= statics::memory;
+        return false;
+    }
+
+    // Move the unions in use over to the new array
+    std::copy( keys, keys + words(), grown );
+    free_list();
+
+    keys = grown;
+    capacity = count;
+    pooled = ( pool != nullptr );
+
+    return true;
+}
+
+/**
+ * @brief Copies the unions of another orbit
+ * @details Copies the orbit_key_t values which contain the path information into the inline unions, or into a heap array
+ * sized to fit if the orbit is longer than those can hold.
+ * @param [in] ro - Const reference to the orbit to replicate.
+ */
+void orbit_t::copy_list( const orbit_t &ro )
+{
+    int count = ro.words();
+
+    // Start over with the inline unions if the current heap array is too small
+    if ( count > capacity )
+    {
+        free_list();
+        keys = local;
+        capacity = inline_words;
+        pooled = false;
+        path_length = code_length = 0;
+
+        if ( !reserve( count ) )
+            return;
+    }
+
+    // Copy the path length, code length, fingerprint and error mask
+    path_length = ro.path_length;
+    code_length = ro.code_length;
+    hash_key = ro.hash_key;
+    error_mask = ro.error_mask;
+
+    // Copy the orbit as long integers
+    std::copy( ro.keys, ro.keys + count, keys );
+};
+
+/**
+ * @brief Takes over the unions of another orbit
+ * @details A heap or arena array simply changes hands, while inline unions have to be copied.  Either way the other orbit is
+ * left as an empty orbit using its own inline unions.  This orbit must not hold a heap array when this is called.
+ * @param [in] ro - Reference to the orbit to take the unions from.
+ */
+void orbit_t::move_list( orbit_t &ro )
+{
+    // Copy the path length, code length, fingerprint and error mask
+    path_length = ro.path_length;
+    code_length = ro.code_length;
+    hash_key = ro.hash_key;
+    error_mask = ro.error_mask;
+
+    // Inline unions cannot change hands so copy them
+    if ( ro.keys == ro.local )
+        std::copy( ro.local, ro.local + ro.words(), local );
+
+    // Otherwise take over the array
+    else
+    {
+        keys = ro.keys;
+        capacity = ro.capacity;
+        pooled = ro.pooled;
+    }
+
+    ro.init();
+}
+
+/**
+ * @brief Frees up the heap array if there is one
+ * @details An array taken from an arena is left for the arena to release.  Deallocation is necessary whenever the unions are
+ * moved to a larger array and when the orbit_t object is destructed.
+ */
+void orbit_t::free_list()
+{
+    if ( keys != local && !pooled )
+        delete[] keys;
+};
+
+/**
+ * @brief Initializes the object variables
+ * @details Initially the only unions available for writing to are the inline ones, and the first of them is cleared since an
+ * empty orbit compares as a single zero union.
+ */
+void orbit_t::init()
+{
+    // Clear all state
+    path_length = code_length = error_mask = 0;
+    hash_key = empty_hash;
+
+    // Point at the inline unions and clear the first
+    keys = local;
+    capacity = inline_words;
+    pooled = false;
+    keys[ 0 ].i_key = 0;
+};
+
+/**
+ * @brief Hash an orbit_t by returning its fingerprint
+ * @param [in] o - Const reference to the orbit to hash.
+ * @return size_t - The fingerprint of the orbit.
+ */
+size_t std::hash< orbit_t >::operator()( const orbit_t &o ) const noexcept
+{
+    return o.fingerprint();
+}
+
+// Template struct t_orbit implementations
+
+/**
+ * @brief Append a numerical path element after checking that it fits in the element width
+ * @tparam E - The unsigned integer type of an orbit element.
+ * @param [in] divisors - The const power of 2 exponent which can be factored after a Collatz 3n+1 connection.
+ */
+template < class E >
+void t_orbit< E >::append( const long divisors )
+{
+    // Ensure that the number of divisors fits in the element type
+    if ( divisors > max_element ) {
+        throw std::logic_error( "Divisors exceed the orbit element width; adjust the element type." );
+    }
+
+    orbit_t::append( divisors );
+}
+
+// Template class implementation for the path class variants
+
+// Template t_path constructors
+
+/**
+ * @brief Default constructor for a new t_path< P >::t_path object
+ * @details Calls the init() member function to initialize the member variables.
+ * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
+ */
+template < class P, class M >
+t_path< P, M >::t_path()
+{
+    init();
+}
+
+/**
+ * @brief Constructor for a new t_path< P >::t_path object given an integer
+ * @details Calculates the path for the provided integer and determines it's nominal equivalence class.
+ * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
+ * @param [in] start - The starting integer of the template type - or one which has a defined conversion to the template type.
+ */
+template < class P, class M >
+t_path< P, M >::t_path( const P &start )
+{
+    operator=( start );
+}
+
+/**
+ * @brief Constructor for a new t_path< P >::t_path object given an integer and an equivalence class length
+ * @details Calculates the path for the provided integer and assigns it to its specified equivalence class length.
+ * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
+ * @param [in] start - The const starting integer of the template type - or one which has a defined conversion to the template type.
+ * @param [in] class_len - The specified equivalence class length.
+ */
+template < class P, class M >
+t_path< P, M >::t_path( const P &start, long class_len )
+{
+    setpath( start, class_len );
+
+    // Check for negative values and assign
+    ec_len = ( class_len < 0 ) ? 0 : class_len;
+}
+
+/**
+ * @brief Constructor for a new t_path< P >::t_path object given its equivalence class string representation
+ * @details Parses the equivalence class to extract the leading integer from the class.
+ * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
+ * @param [in] input - Const reference to an equivalence class std::string representation.
+ */
+template < class P, class M >
+t_path< P, M >::t_path( const std::string &input )
+{
+    // Parse the input string to come up with an integer representation which can then be used to create to the object
+    P val = parse( input );
+
+    setpath( val );
+    ec_len = get_ec_len( input );
+}
+
+/**
+ * @brief Constructor for a new t_path< P >::t_path object given its equivalence class character array representation
+ * @details Parses the equivalence class to extract the leading integer from the class.
+ * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
+ * @param [in] input - Const reference to an equivalence class character array representation.
+ */
+template < class P, class M >
+t_path< P, M >::t_path( const char input[] )
+{
+    // Parse the characters array to come up with an integer representation which can then be used to create to the object
+    P val = parse( input );
+
+    setpath( val );
+    ec_len = get_ec_len( input );
+}
+
+/**
+ * @brief Destructor for the t_path< P >::t_path object
+ * @details Currently just zeroes out all values and as such is likely not strictly necessary.
+ * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
+ */
+template < class P, class M >
+t_path< P, M >::~t_path()
+{
+    zeroize();
+}
+
+/**
+ * @brief Set the value for path object (deletes existing state first)
+ * @details This member function does quite a bit.  It is called by t_path<> constrcutors or directly for existing objects.
+ * It first established the integer starting point for convergence and then calculates the entire oribital path needed to
+ * be able to converge to a smaller integer.  This keep track of the total number of factors of 2 used in convergence as well
+ * as the number of divergent 3n+1 connections.  The main loop exits once the new integer in the orbit is no longer greater
+ * that the starting integer.  This means it also exists upon equivalency which is needed as the termination condition at the
+ * global terminus of 1.  Finally it initialize the number of factors of 2 in the equivalence class (which is greatet than
+ * or equal to the path factors) and looks ahead to see the number of factors of 2 after then ext 3n+1 connections.
+ * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
+ * @param [in] start - The initial integer that you need to search for a convergent flow for.
+ * @param [in] max_factors - Optional upper limit on the number of factors of 2 in the path (defaults to zero).
+ */
+template < class P, class M >
+void t_path< P, M >::setpath( const P &start, int max_factors )
+{
+    // The standard 3n+1 connection for positive built-in integers is handed off to the trailing zero count kernel
+    if constexpr ( std::is_integral< P >::value )
+    {
+        if ( start > 0 && M::standard() )
+        {
+            setpath_ctz( start, max_factors );
+            return;
+        }
+    }
+
+#ifdef gnu_mp
+    // The same holds for positive multiple precision integers which are handed off to the in-place GMP kernel
+    if constexpr ( std::is_same< P, mpz_class >::value )
+    {
+        if ( start > 0 && M::standard() )
+        {
+            setpath_mpz( start, max_factors );
+            return;
+        }
+    }
+#endif
+
+    // Clear any existing state and initialize to the start value
+    init( start );
+
+    // Set the current and maximum integer in orbit to starting integer
+    P current_int = start;
+    max_int = start;
+
+    // Eliminate the even numbers first, they converge immediately
+    if ( start % M::divisor() == 0 )
+    {
+        // All numbers which divide evenly by the divisor converge locally with a minimum of a single factor of the divisor
+        orb.append( 1 );
+        path_factors++;
+    }
+    
+    // Otherwise its odd, diverges and you need to figure out how it converges
+    else
+    {
+        // All other paths begin with 0 since they cannot be divided evenly by the divisor
+        orb.append( 0 );
+
+        // Loop until you find a smaller magnitude
+        do
         {
             long leg = 0;
             P last_int = current_int;
@@ -637,17 +888,17 @@ void t_path< P >::setpath( const P &start, int max_factors )
     if ( current_int != 0 )
     {
         // Eliminate any residual divisor factors from remainder
-        while ( current_int % statics::divisor == 0 )
+        while ( current_int % M::divisor() == 0 )
         {
-           current_int /= statics::divisor;
+           current_int /= M::divisor();
            ec_factors++;                // Counting this produces classic maxfacts
         }
 
         // Now clean up any divisor factors from the starting integer before finding the next
         current_int = start;
-        while ( current_int % statics::divisor == 0 )
+        while ( current_int % M::divisor() == 0 )
         {
-           current_int /= statics::divisor;
+           current_int /= M::divisor();
         }
 
         // Find the number of divisor factors to get to the next local terminus
@@ -656,13 +907,117 @@ void t_path< P >::setpath( const P &start, int max_factors )
     }
 }
 
+/**
+ * @brief Compute the convergence statistics of a starting integer without building a path object
+ * @details This walks exactly the same convergent orbit as setpath() but keeps only the running totals, so no orbit is recorded,
+ * no equivalence class length is computed and the next local terminus is not looked up.  Positive integers under the standard
+ * 3n+1 connection are handed off to the same kind of kernel setpath() uses.  A connection in the orbit which cannot be represented
+ * throws std::overflow_error just as it does in setpath(), but since the next local terminus is never looked up an integer whose
+ * orbit fits will not overflow on account of that connection.
+ * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
+ * @param [in] start - The initial integer to find the convergent flow for.
+ * @return t_path_stats< P > - The path length, path factors, class factors and maximum integer of the orbit.
+ */
+template < class P, class M >
+t_path_stats< P > t_path< P, M >::stats( const P &start )
+{
+    t_path_stats< P > s;
+
+    s.path_len = 1;
+    s.path_factors = s.class_factors = 0;
+    s.max_int = start;
+    s.error_mask = 0;
+
+    bool standard = M::standard();
+
+    // The standard 3n+1 connection for positive built-in integers is handed off to the trailing zero count kernel
+    if constexpr ( std::is_integral< P >::value )
+    {
+        if ( start > 0 && standard )
+        {
+            stats_ctz( start, s );
+            return s;
+        }
+    }
+
+#ifdef gnu_mp
+    // The same holds for positive multiple precision integers which are handed off to the in-place GMP kernel
+    if constexpr ( std::is_same< P, mpz_class >::value )
+    {
+        if ( start > 0 && standard )
+        {
+            stats_mpz( start, s );
+            return s;
+        }
+    }
+#endif
+
+    P current_int = start;
+
+    // Eliminate the even numbers first, they converge immediately
+    if ( start % M::divisor() == 0 )
+        s.path_factors++;
+
+    // Otherwise its odd, diverges and you need to figure out how it converges
+    else
+    {
+        do
+        {
+            P last_int = current_int;
+
+            // Find the next even integer using the connection
+            current_int = connection( current_int );
+
+            // if the sign has flipped we've hit a representation limit - print message and break out of loop
+            if ( sgn( start ) != sgn( current_int ) )
+            {
+                std::cout << "Error: Signed integer overflow for starting integer " << start << 
+                        ".  Connection for " << last_int << " in orbit was too big to represent." << std::endl;
+
+                s.error_mask |= statics::overflow;
+
+                current_int = last_int;
+                break;
+            }
+
+            // Record the largest integer achieved during convergent segment
+            if ( current_int > s.max_int )
+                s.max_int = current_int;
+
+            // Count the downleg and the factors of the divisor removed on it
+            s.path_factors += factor( current_int, start );
+            s.path_len++;
+        }
+
+        // Loop until the current integer magnitude is less that the starting point - in other words once the orbit converges
+        while ( abs( current_int ) > abs( start ) );
+    }
+
+    // At a minimum the equivalence factors is the same as the path factors
+    s.class_factors = s.path_factors;
+
+    // Eliminate any residual divisor factors from remainder
+    if ( current_int != 0 )
+    {
+        while ( current_int % M::divisor() == 0 )
+        {
+           current_int /= M::divisor();
+           s.class_factors++;
+        }
+    }
+
+    return s;
+}
+
 /**
  * @brief Retrieve the path as a std::string object (e.g. 0 1 2 1 2 1 3)
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @return std::string - Returns the path by calling the orbit::path() function.
  */
-template < class P >
-std::string t_path< P >::getpath() const
+template < class P, class M >
+std::string t_path< P, M >::getpath() const
 {
     return orb.path();
 }
@@ -684,11 +1039,12 @@ std::string t_path< P >::getpath() const
  * On the other hand, any given equivalence class may not be sufficently specific (long enough) to guarantee that all members of the
  * class converge identically in which case the convergence patter does not include all connections, for exmaple +301001101.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] digits - Desired nubmer of digits in the representation.  Defaults to -1 which is a signal to use the standard class length.
  * @return std::string - Return the flow representation in signed hex binary notation.
  */
-template < class P >
-std::string t_path< P >::flow( long digits ) const
+template < class P, class M >
+std::string t_path< P, M >::flow( long digits ) const
 {
     if ( digits < 0 )
         digits = ec_len;
@@ -696,10 +1052,10 @@ std::string t_path< P >::flow( long digits ) const
     std::string flowrep = "";
 
     // Initiailize factors by starting with the local value divided by the multiplier
-    P factors = start_int / statics::multiplier;
+    P factors = start_int / M::multiplier();
 
     // Initiailize the remainder by first finding the residual which will become the leading digit
-    P remainder = start_int % ( statics::divisor * statics::multiplier );
+    P remainder = start_int % ( M::divisor() * M::multiplier() );
 
     // Protect against negative number arguments
     digits = ( digits < 0 ) ? 0 : digits;
@@ -726,10 +1082,10 @@ std::string t_path< P >::flow( long digits ) const
         flowrep += to_str( absolute );
 
         // Set up for next digits
-        factors /= statics::divisor;
+        factors /= M::divisor();
 
         // Get ready for next iteration of do loop
-        remainder = factors % statics::divisor;          
+        remainder = factors % M::divisor();          
     }
 
     return flowrep;
@@ -742,20 +1098,21 @@ std::string t_path< P >::flow( long digits ) const
  * all ancestors may be related to each other by factors of 4n+1 (although I haven't yet figured out why) - but this algorith does
  * NOT presume this to be true.  Instead it computes the inverse connection formula to attempt to find the ancestors. 
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [out] scale - The scale is really a convenience for external loops so that the same ancestor is not found repetitively. It is
  * used to multiply the starting integer so that the search resumes beyond where the past ancestor was found.  The scale value is a
  * reference so altough it uses the provided scale as the intial value is does modify it as needed and returns the modified value,
  * @return P - Returns the integer which is a parent integer which leads to the staring integer.  Returns 0 if no parents are possible.
  */
-template < class P >
-P t_path< P >::ancestry( long &scale ) const
+template < class P, class M >
+P t_path< P, M >::ancestry( long &scale ) const
 {
     // First check is to see if the number is a multiple of the divisor - there is no parent
-    if ( start_int == ( start_int / statics::divisor ) * statics::divisor )
+    if ( start_int == ( start_int / M::divisor() ) * M::divisor() )
         return 0;
 
     // Next check is to see if the number is a multiple of the multiplier - there is no parent
-    if ( start_int == ( start_int / statics::multiplier ) * statics::multiplier )
+    if ( start_int == ( start_int / M::multiplier() ) * M::multiplier() )
         return 0;
 
     // The starting integers which remain after passing these tests have parents
@@ -766,8 +1123,8 @@ P t_path< P >::ancestry( long &scale ) const
     // Note this does NOT check for integer rollover for large integers
     do
     {
-        parent = scale * start_int * statics::divisor - statics::addend;
-        parent /= statics::multiplier;
+        parent = scale * start_int * M::divisor() - M::addend();
+        parent /= M::multiplier();
 
         P child = connection( parent );
         term( child );
@@ -791,22 +1148,23 @@ P t_path< P >::ancestry( long &scale ) const
 /**
  * @brief Return the next integer in an orbit
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @return P - If the value is odd (a local terminus) this return the 3n+1 connection, otherwise for even with one factor of 2 removed.
  */
-template < class P >
-P t_path< P >::next() const
+template < class P, class M >
+P t_path< P, M >::next() const
 {
-    P next_int = start_int % statics::divisor;          // Initialize to the remainder of mod by divisor
+    P next_int = start_int % M::divisor();          // Initialize to the remainder of mod by divisor
 
     // Check to see if the value is unevenly divisible by the divisor - in other words it a terminus
-    if ( next_int % statics::divisor != 0 )
+    if ( next_int % M::divisor() != 0 )
     {
         // If so then return the next connection value - un-reduced to the terminus
         return connection( start_int );
     }
 
     // Otherwise simply return the next integer in orbit
-    return start_int / statics::divisor;
+    return start_int / M::divisor();
 }
 
 
@@ -815,10 +1173,11 @@ P t_path< P >::next() const
 /**
  * @brief Return the starting integer
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @return P - The staring integer.
  */
-template < class P >
-P t_path< P >::start() const
+template < class P, class M >
+P t_path< P, M >::start() const
 {
     return start_int;
 }
@@ -827,10 +1186,11 @@ P t_path< P >::start() const
  * @brief The maximum integer visited during a convergent segment.
  * @details  The setpath() menber function determines the maximum integer value during initialization process.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @return P - The maximum integer in the convergence segment.
  */
-template < class P >
-P t_path< P >::max() const
+template < class P, class M >
+P t_path< P, M >::max() const
 {
     return max_int;
 }
@@ -838,10 +1198,11 @@ P t_path< P >::max() const
 /**
  * @brief Returns the orbit.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @return const orbit_t& - Return a const reference to the orbig object.
  */
-template < class P >
-const orbit_t& t_path< P >::orbit()
+template < class P, class M >
+const orbit_t& t_path< P, M >::orbit() const
 {
     return orb;
 }
@@ -849,10 +1210,11 @@ const orbit_t& t_path< P >::orbit()
 /**
  * @brief Return the sign of the integer
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @return int - Sign of the integer.
  */
-template < class P >
-int t_path< P >::sign() const
+template < class P, class M >
+int t_path< P, M >::sign() const
 {
     return int_sign;
 }
@@ -860,11 +1222,12 @@ int t_path< P >::sign() const
 /**
  * @brief Error code
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @return int - Error code.  Really only relevant when using standard precision integers which may exceed the internal limits.  Errors
  * are currently not applicable to multiple precision integers when using the GNU MP libraries.
  */
-template < class P >
-int t_path< P >::error() const
+template < class P, class M >
+int t_path< P, M >::error() const
 {
     return error_mask | orb.error();
 }
@@ -872,10 +1235,11 @@ int t_path< P >::error() const
 /**
  * @brief Return the number if downlegs in the orbit.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @return long - The number of downlegs (3n+1 connections) in the convergent orbit.
  */
-template < class P >
-long t_path< P >::pathLength() const
+template < class P, class M >
+long t_path< P, M >::pathLength() const
 {
     return orb.path_len();
 }
@@ -885,10 +1249,11 @@ long t_path< P >::pathLength() const
  * @details This value is either computed automatically when an integer is provided as the starting point or as passed as an initial
  * value when define a class length.  For example the equivalence class for 23 is +51100, thus classLength() is 5.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @return long - The number of digits in the equivalence class representation.
  */
-template < class P >
-long t_path< P >::classLength() const
+template < class P, class M >
+long t_path< P, M >::classLength() const
 {
     return ec_len;
 }
@@ -897,10 +1262,11 @@ long t_path< P >::classLength() const
  * @brief The aggregate number of factors of 2 in the orbit
  * @details This is the sum of the orbit path, for example the path for 15 is 0 1 1 1 4, thus pathFactors() is 7
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @return long - Total factors of 2 from the entire convergent orbit
  */
-template < class P >
-long t_path< P >::pathFactors() const
+template < class P, class M >
+long t_path< P, M >::pathFactors() const
 {
     return path_factors;
 }
@@ -911,10 +1277,11 @@ long t_path< P >::pathFactors() const
  * which result in convergence - but the converged (lower) integer may be even and thus further divisible by 2.  Thus classFactors()
  * instead finds all of factors of 2 until it reaches the next local terminus which is an odd value.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @return long - The total number of factors of 2 for the equivalence class to get to the convergent local terminus.
  */
-template < class P >
-long t_path< P >::classFactors() const
+template < class P, class M >
+long t_path< P, M >::classFactors() const
 {
     return ec_factors;
 }
@@ -952,10 +1319,11 @@ long t_path< P >::classFactors() const
  * @endcode
  * 
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @return long - The number of factors of two following the next 3n+1 connection.
  */
-template < class P >
-long t_path< P >::nextFactors() const
+template < class P, class M >
+long t_path< P, M >::nextFactors() const
 {
     return next_factors;
 }
@@ -963,28 +1331,16 @@ long t_path< P >::nextFactors() const
 
 // Path operators
 
-/**
- * @brief Assignment operator
- * @details Replicates the path object by extracting the starting integer and regenerating.
- * @tparam P - The integer data type.
- * @param [in] rp - Const reference to the path object to replicate.
- * @return t_path< P >& - Returns a reference to this object
- */
-template < class P >
-t_path< P > &t_path< P >::operator = ( const t_path< P > &rp )
-{
-    return operator= ( rp.start() );
-}
-
 /**
  * @brief Assignement operator.  Used also in constructors
  * @details Replicates the path object by extracting the starting integer and regenerating.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] rp - Const reference to the integer object of type P.
  * @return t_path< P >& - Returns a reference to this object
  */
-template < class P >
-t_path< P > &t_path< P >::operator = ( const P &rp )
+template < class P, class M >
+t_path< P, M > &t_path< P, M >::operator = ( const P &rp )
 {
     setpath( rp );
     set_ec( rp );
@@ -996,32 +1352,28 @@ t_path< P > &t_path< P >::operator = ( const P &rp )
  * @brief Equivalency check
  * @details Returns the orbit compare results.  Not this does \b not compare the starting integer values.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] rp - Const reference to the path object to replicate.
  * @return true - The paths are equivalent
  * @return false - The paths are different
  */
-template < class P >
-bool t_path< P >::operator == ( const t_path< P > &rp ) const
+template < class P, class M >
+bool t_path< P, M >::operator == ( const t_path< P, M > &rp ) const
 {
-    // If the path lengths are unequal then its a no-brainer that they are not equal
-    if ( orb.path_len() != rp.orb.path_len() )
-        return false;
-    
-    // Otherwise do a more rigourous comparison
-    else
-        return orb == rp.orb;
+    return orb == rp.orb;
 }
 
 /**
  * @brief Inequivalency check
  * @details Returns the orbit compare results.  Not this does \b not compare the starting integer values.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] rp - Const reference to the path object to replicate.
  * @return true - The paths are different
  * @return false - The paths are equivalent
  */
-template < class P >
-bool t_path< P >::operator != ( const t_path< P > &rp ) const
+template < class P, class M >
+bool t_path< P, M >::operator != ( const t_path< P, M > &rp ) const
 {
     return !( orb == rp.orb );
 }
@@ -1030,12 +1382,13 @@ bool t_path< P >::operator != ( const t_path< P > &rp ) const
  * @brief Ordinal less than comparison
  * @details Returns the orbit less than comparison results.  Less than means it's integer union representation is less.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] rp - Const reference to the path object to compare to.
  * @return true - The path is less than the argument orbit
  * @return false - The path is greater than or equal to the argument orbit
  */
-template < class P >
-bool t_path< P >::operator < ( const t_path< P > &rp ) const
+template < class P, class M >
+bool t_path< P, M >::operator < ( const t_path< P, M > &rp ) const
 {
     // Compare the orbits
     return orb < rp.orb;
@@ -1045,12 +1398,13 @@ bool t_path< P >::operator < ( const t_path< P > &rp ) const
  * @brief Ordinal greater than comparison
  * @details Returns the orbit less than comparison results.  Greater than means it's integer union representation is greater.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] rp - Const reference to the path object to compare to.
  * @return true - The path is greater than the argument orbit
  * @return false - The path is less than or equal to the argument orbit
  */
-template < class P >
-bool t_path< P >::operator > ( const t_path< P > &rp ) const
+template < class P, class M >
+bool t_path< P, M >::operator > ( const t_path< P, M > &rp ) const
 {
     // Compare the orbits
     return orb > rp.orb;
@@ -1060,12 +1414,13 @@ bool t_path< P >::operator > ( const t_path< P > &rp ) const
  * @brief Ordinal less than or equal to comparison
  * @details Returns the orbit less than comparison results.  False means it's integer union representation is greater.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] rp - Const reference to the path object to compare to.
  * @return true - The path is less than or equal to the argument orbit
  * @return false - The path is greater than the argument orbit
  */
-template < class P >
-bool t_path< P >::operator <= ( const t_path< P > &rp ) const
+template < class P, class M >
+bool t_path< P, M >::operator <= ( const t_path< P, M > &rp ) const
 {
     // Compare the orbits
     return !( orb > rp.orb );
@@ -1075,12 +1430,13 @@ bool t_path< P >::operator <= ( const t_path< P > &rp ) const
  * @brief Ordinal greater than or equal to comparison
  * @details Returns the orbit less than comparison results.  False means it's integer union representation is less.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] rp - Const reference to the path object to compare to.
  * @return true - The path is greater than or equal to the argument orbit
  * @return false - The path is less than the argument orbit
  */
-template < class P >
-bool t_path< P >::operator >= ( const t_path< P > &rp ) const
+template < class P, class M >
+bool t_path< P, M >::operator >= ( const t_path< P, M > &rp ) const
 {
     // Compare the orbits
     return !( orb < rp.orb );
@@ -1090,9 +1446,10 @@ bool t_path< P >::operator >= ( const t_path< P > &rp ) const
  * @brief Print out the equivalence class in its nominal form.  Neither truncated not extended.
  * @details The number of digits in the representation is given by pathLength().
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  */
-template < class P >
-void t_path< P >::prettyPrint() const
+template < class P, class M >
+void t_path< P, M >::prettyPrint() const
 {
     prettyPrint( ec_len, 0 );
 }
@@ -1102,10 +1459,11 @@ void t_path< P >::prettyPrint() const
  * @details The first column width is defined by the argument max_digits which is the number of digits in the \b largest integer
  * in this convergent segment.  This number of digits is used to right justify the first column the output so it is easier to read.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] max_digits - The maximum number of base 10 digits in the first column (used for right justification).
  */
-template < class P >
-void t_path< P >::prettyPrint( int max_digits ) const
+template < class P, class M >
+void t_path< P, M >::prettyPrint( int max_digits ) const
 {
     prettyPrint( ec_len, max_digits );
 }
@@ -1115,13 +1473,14 @@ void t_path< P >::prettyPrint( int max_digits ) const
  * @details The first column width is defined by the argument max_digits which is the number of digits in the \b largest integer
  * in this convergent segment.  This number of digits is used to right justify the first column the output so it is easier to read.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] len - Length of the convergence class for the convergent flow segment.
  * @param [in] max_digits - The maximum number of base 10 digits in the first column (used for right justification).
  */
-template < class P >
-void t_path< P >::prettyPrint( long len, int max_digits ) const
+template < class P, class M >
+void t_path< P, M >::prettyPrint( long len, int max_digits ) const
 {
-    pathPrint( start_int, pathLength(), ( len < 0 ) ? 0 : len, 0, flow(len), max_digits );
+    pathPrint( start_int, pathLength(), ( len < 0 ) ? 0 : len, 0, flow( len ).c_str(), max_digits, M::multiplier() );
 }
 
 /**
@@ -1129,24 +1488,26 @@ void t_path< P >::prettyPrint( long len, int max_digits ) const
  * @details The first column width is defined by the argument max_digits which is the number of digits in the \b largest integer
  * in this convergent segment.  This number of digits is used to right justify the first column the output so it is easier to read.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] len - Length of the convergence class for the convergent flow segment.
  * @param [in] indent - Indents the equivalnce class representation so convergent and divergent flows are visible.
  * @param [in] max_digits - The maximum number of base 10 digits in the first column (used for right justification).
  */
-template < class P >
-void t_path< P >::prettyPrint( long len, long indent, int max_digits ) const
+template < class P, class M >
+void t_path< P, M >::prettyPrint( long len, long indent, int max_digits ) const
 {
-    pathPrint( start_int, pathLength(), ( len < 0 ) ? 0 : len, ( indent < 0 ) ? 0 : indent, flow(len), max_digits );
+    pathPrint( start_int, pathLength(), ( len < 0 ) ? 0 : len, ( indent < 0 ) ? 0 : indent, flow( len ).c_str(), max_digits, M::multiplier() );
 }
 
 /**
  * @brief Print out the equivalence class whose length is limited to the \b total number of factors of 2
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  */
-template < class P >
-void t_path< P >::prettyPrintClass() const
+template < class P, class M >
+void t_path< P, M >::prettyPrintClass() const
 {
-    pathPrint( start_int, pathLength(), pathFactors(), 0, flow(pathFactors()), 0 );
+    pathPrint( start_int, pathLength(), pathFactors(), 0, flow( pathFactors() ).c_str(), 0, M::multiplier() );
 }
 
 /**
@@ -1154,12 +1515,13 @@ void t_path< P >::prettyPrintClass() const
  * @details The first column width is defined by the argument max_digits which is the number of digits in the \b largest integer
  * in this convergent segment.  This number of digits is used to right justify the first column the output so it is easier to read.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] max_digits - The maximum number of base 10 digits in the first column (used for right justification).
  */
-template < class P >
-void t_path< P >::prettyPrintClass( int max_digits ) const
+template < class P, class M >
+void t_path< P, M >::prettyPrintClass( int max_digits ) const
 {
-    pathPrint( start_int, pathLength(), pathFactors(), 0, flow(pathFactors()), max_digits );
+    pathPrint( start_int, pathLength(), pathFactors(), 0, flow( pathFactors() ).c_str(), max_digits, M::multiplier() );
 }
 
 /**
@@ -1167,11 +1529,16 @@ void t_path< P >::prettyPrintClass( int max_digits ) const
  * @details This format shows in detail the factors of 2 at each step in the convergent orbit.  The \b total number of factors of 2
  * in the entire sequence is classFactors().
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  */
-template < class P >
-void t_path< P >::prettyPrintPath() const
+template < class P, class M >
+void t_path< P, M >::prettyPrintPath() const
 {
-    pathPrint( start_int, pathLength(), path_factors, 0, orb.path(), 0 );
+    char buffer[ orbit_view::buffer_size ];
+    std::string spill;
+
+    // Format the orbit on the stack so printing a pathway does not allocate
+    pathPrint( start_int, pathLength(), path_factors, 0, orb.view().text( buffer, sizeof( buffer ), spill ), 0, M::multiplier() );
 }
 
 /**
@@ -1182,12 +1549,31 @@ void t_path< P >::prettyPrintPath() const
  * The first column width is defined by the argument max_digits which is the number of digits in the \b largest integer
  * in this convergent segment.  This number of digits is used to right justify the first column the output so it is easier to read.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] max_digits - The maximum number of base 10 digits in the first column (used for right justification).
  */
-template < class P >
-void t_path< P >::prettyPrintPath( int max_digits ) const
+template < class P, class M >
+void t_path< P, M >::prettyPrintPath( int max_digits ) const
+{
+    char buffer[ orbit_view::buffer_size ];
+    std::string spill;
+
+    // Format the orbit on the stack so printing a pathway does not allocate
+    pathPrint( start_int, pathLength(), path_factors, 0, orb.view().text( buffer, sizeof( buffer ), spill ), max_digits, M::multiplier() );
+}
+
+
+/**
+ * @brief Hash a path object by the fingerprint of its orbit
+ * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
+ * @param [in] p - Const reference to the path object to hash.
+ * @return size_t - The fingerprint of the orbit.
+ */
+template < class P, class M >
+size_t std::hash< t_path< P, M > >::operator()( const t_path< P, M > &p ) const noexcept
 {
-    pathPrint( start_int, pathLength(), path_factors, 0, orb.path(), max_digits );
+    return p.orbit().fingerprint();
 }
 
 
@@ -1197,14 +1583,15 @@ void t_path< P >::prettyPrintPath( int max_digits ) const
  * @brief Calculate the 3n+1 Collatz Connection.  Quite simply, this is the center of all of this.
  * 
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] terminus - The (odd) positive integer from which to need to compute the (even) connection.
  * @return P - Return the (even) 3n+1 connection from the (odd) local terminus.
  */
-template < class P >
-P t_path< P >::connection( const P &terminus ) const
+template < class P, class M >
+P t_path< P, M >::connection( const P &terminus )
 {
-    P next_int = safe_arith<P>::mul( terminus, statics::multiplier );     // This is the 3n part of the connection - always safe
-    return safe_arith<P>::add( next_int, statics::addend );        // This is the +1 part of the connection - always safe
+    P next_int = safe_arith<P>::mul( terminus, M::multiplier() );     // This is the 3n part of the connection - always safe
+    return safe_arith<P>::add( next_int, M::addend() );        // This is the +1 part of the connection - always safe
 }
 
 /**
@@ -1212,11 +1599,12 @@ P t_path< P >::connection( const P &terminus ) const
  * @details The program accept equivalence class input string and this parses them to find the leading integer of the class.  The class
  * can carry an option sign indicator - the lack of which is taken to mean positive.
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] input - The std::string object holding the character string representation.
  * @return P - Returns the integer value computed - or 0 if there was an erro during parsing.
  */
-template < class P >
-P t_path< P >::parse( const std::string &input )
+template < class P, class M >
+P t_path< P, M >::parse( const std::string &input )
 {
     long pos = 0;                   // Position in the string
     long eq_sign = 1;               // Presume positive equivalence class
@@ -1251,7 +1639,7 @@ P t_path< P >::parse( const std::string &input )
 
     // Otherwise the first character is indeed valid so "convert" to character to integer
     P local = static_cast<P>(ch - '0');
-    P multiplier = static_cast<P>(statics::multiplier * statics::divisor);
+    P multiplier = static_cast<P>(M::multiplier() * M::divisor());
 
     // Consume all digits in the equivalence class representation
     while ( --strlen > 0 )
@@ -1298,11 +1686,12 @@ P t_path< P >::parse( const std::string &input )
  * @brief Compute and return the number of factors of the divisor (2), and return the argument with those factors removed
  * 
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [out] i - The number from which to extract all factors of two and which will return with those factors removed
  * @return long - The number of factors of of the divisor (2) extracted from the argument.
  */
-template < class P >
-long t_path< P >::term( P &i ) const
+template < class P, class M >
+long t_path< P, M >::term( P &i ) const
 {
     long facts = 0;
 
@@ -1310,9 +1699,9 @@ long t_path< P >::term( P &i ) const
     if ( i != 0 )
     {
         // Loop until all factors are removed and return the number of them
-        while ( i % statics::divisor == 0 )
+        while ( i % M::divisor() == 0 )
         {
-            i /= statics::divisor;       // Divide but the divisor
+            i /= M::divisor();       // Divide but the divisor
             facts++;
         }
     }
@@ -1324,12 +1713,13 @@ long t_path< P >::term( P &i ) const
  * @brief Return the factors of the divisor (2) from a branch point - but stop if you converge
  * 
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [out] branch - Factor out divisors, but stop if you find convergence.
  * @param [in] start - The integer starting point.  If even the factorization results in something smaller in magnitude, stop.
  * @return long - The number of divisor factors removed.
  */
-template < class P >
-long t_path< P >::factor( P &branch, const P &start )
+template < class P, class M >
+long t_path< P, M >::factor( P &branch, const P &start )
 {
     long facts = 0;         // Divisor factor counter
 
@@ -1343,10 +1733,10 @@ long t_path< P >::factor( P &branch, const P &start )
     }
 
     // Loop until you're eaten up all the factors of the divisor
-    while ( branch % statics::divisor == 0 )
+    while ( branch % M::divisor() == 0 )
     {
         // Divide the divisor out - note that because this argument is by reference the variable in the caller changes too
-        branch /= statics::divisor;
+        branch /= M::divisor();
         facts++;
 
         // Exit early if you converge
@@ -1359,19 +1749,427 @@ long t_path< P >::factor( P &branch, const P &start )
     return facts;
 }
 
+/**
+ * @brief Trailing zero count kernel for setpath() on positive built-in integers under the standard 3n+1 connection
+ * @details This produces exactly the same orbit, maximum integer, factor counts and overflow behaviour as the generic setpath()
+ * loop, but works on the unsigned magnitude so that no sign checks or abs() calls are needed inside the loop.  Rather than
+ * peeling factors of 2 off one at a time with the % and / operators, all of them are counted with a single trailing zero count.
+ * 
+ * The convergence check in factor() stops dividing as soon as the branch drops below the starting integer.  That point can be
+ * located without stepping because shifting right by k bits changes the bit width by exactly k.  Any shift smaller than the
+ * difference in bit widths of the branch and the start leaves the branch larger than the start, and one more than that
+ * difference always leaves it smaller.  So at most one comparison is needed to locate the convergence point within a downleg.
+ * 
+ * Just as in the generic path a connection which cannot be represented throws std::overflow_error from the same point.
+ * @tparam P - The integer data type.  Must be a built-in integer type.
+ * @tparam M - The Collatz map policy.
+ * @param [in] start - The positive initial integer to find the convergent flow for.
+ * @param [in] max_factors - Upper limit on the number of factors of 2 in the path when in speed mode.
+ */
+template < class P, class M >
+void t_path< P, M >::setpath_ctz( const P &start, int max_factors )
+{
+    typedef std::make_unsigned_t< P > U;
+
+    // Largest odd magnitude whose 3n+1 connection is still representable as type P
+    const U limit = ( static_cast< U >( std::numeric_limits< P >::max() ) - 1 ) / 3;
+
+    // Clear any existing state and initialize to the start value
+    init( start );
+
+    const U start_mag = static_cast< U >( start );
+    const int start_width = std::bit_width( start_mag );
+
+    U current = start_mag;
+    U largest = start_mag;
+
+    // Optional jump table used to advance several downlegs at a time whenever that is certain to be exact
+    const jump_table *jumps = jump_table::select( statics::jump_bits );
+
+    // Eliminate the even numbers first, they converge immediately with a single factor of 2
+    if ( ( current & 1 ) == 0 )
+    {
+        orb.append( 1 );
+        path_factors++;
+    }
+
+    // Otherwise its odd, diverges and you need to figure out how it converges
+    else
+    {
+        orb.append( 0 );
+
+        do
+        {
+            // Jump while the orbit is far enough above the start to not converge and far enough below the largest integer so
+            // far to not set a new one, and the affine map fits in the unsigned type
+            while ( jumps )
+            {
+                const jump_entry &e = jumps -> entry( static_cast< uint64_t >( current ) );
+                int width = std::bit_width( current );
+
+                if ( e.odd == 0 || width <= start_width + e.drop || width + e.growth >= std::bit_width( largest )
+                                || width + std::bit_width( jumps -> power( e.odd ) ) >= std::numeric_limits< U >::digits )
+                    break;
+
+                current = ( current * jumps -> power( e.odd ) + e.addend ) >> e.steps;
+
+                // Append the downlegs just as they would have been had they been taken one at a time
+                const uint8_t *legs = jumps -> legs( e );
+
+                for ( int i = 0; i < e.odd; i++ )
+                {
+                    path_factors += legs[ i ];
+
+                    if ( statics::speed && ( path_factors > max_factors ) )
+                    {
+                        max_int = static_cast< P >( largest );
+                        return;
+                    }
+
+                    orb.append( legs[ i ] );
+                }
+            }
+
+            // The 3n+1 connection fails in exactly the same place the safe_arith<P> multiplication would
+            if ( current > limit )
+                throw std::overflow_error( "Integer multiplication overflow" );
+
+            current = 3 * current + 1;
+
+            // Record the largest integer achieved during convergent segment
+            if ( current > largest )
+                largest = current;
+
+            // All of the factors of 2 available on this downleg
+            int zeros = std::countr_zero( current );
+
+            // Fewest divisions which could bring the branch below the start, then one more if that was not quite enough
+            int leg = std::bit_width( current ) - start_width;
+
+            if ( leg < 1 )
+                leg = 1;
+
+            if ( leg < zeros && ( current >> leg ) >= start_mag )
+                leg++;
+
+            // Stop at convergence or once the factors of 2 are exhausted, whichever comes first
+            if ( leg > zeros )
+                leg = zeros;
+
+            current >>= leg;
+            path_factors += leg;
+
+            // Abort the complete object creation process if the current number of path factors is greater than the target
+            if ( statics::speed && ( path_factors > max_factors ) )
+            {
+                max_int = static_cast< P >( largest );
+                return;
+            }
+
+            orb.append( leg );
+        }
+
+        // Loop until the current integer is less that the starting point - in other words once the orbit converges
+        while ( current > start_mag );
+    }
+
+    max_int = static_cast< P >( largest );
+
+    // At a minimum the equivalence factors is the same as the path factors plus any residual factors of 2 in the remainder
+    ec_factors = path_factors + std::countr_zero( current );
+
+    // Clean up any factors of 2 from the starting integer and find the number of factors of 2 to get to the next local terminus
+    current = start_mag >> std::countr_zero( start_mag );
+
+    if ( current > limit )
+        throw std::overflow_error( "Integer multiplication overflow" );
+
+    next_factors = std::countr_zero( 3 * current + 1 );
+}
+
+/**
+ * @brief Trailing zero count kernel for stats() on positive built-in integers under the standard 3n+1 connection
+ * @details This is setpath_ctz() with everything but the running totals taken out.  Each downleg is located with a trailing zero
+ * count and a comparison of bit widths just as it is there, and the orbit itself is never stored.
+ * @tparam P - The integer data type.  Must be a built-in integer type.
+ * @tparam M - The Collatz map policy.
+ * @param [in] start - The positive initial integer to find the convergent flow for.
+ * @param [out] s - The statistics which are filled in.
+ */
+template < class P, class M >
+void t_path< P, M >::stats_ctz( const P &start, t_path_stats< P > &s )
+{
+    typedef std::make_unsigned_t< P > U;
+
+    // Largest odd magnitude whose 3n+1 connection is still representable as type P
+    const U limit = ( static_cast< U >( std::numeric_limits< P >::max() ) - 1 ) / 3;
+
+    const U start_mag = static_cast< U >( start );
+    const int start_width = std::bit_width( start_mag );
+
+    U current = start_mag;
+    U largest = start_mag;
+
+    // Even numbers converge immediately with a single factor of 2, the rest diverge until they converge
+    if ( ( current & 1 ) == 0 )
+        s.path_factors++;
+
+    else
+    {
+        do
+        {
+            // The 3n+1 connection fails in exactly the same place the safe_arith<P> multiplication would
+            if ( current > limit )
+                throw std::overflow_error( "Integer multiplication overflow" );
+
+            current = 3 * current + 1;
+
+            if ( current > largest )
+                largest = current;
+
+            // Fewest divisions which bring the branch below the start, limited to the factors of 2 available
+            int zeros = std::countr_zero( current );
+            int leg = std::bit_width( current ) - start_width;
+
+            if ( leg < 1 )
+                leg = 1;
+
+            if ( leg < zeros && ( current >> leg ) >= start_mag )
+                leg++;
+
+            if ( leg > zeros )
+                leg = zeros;
+
+            current >>= leg;
+            s.path_factors += leg;
+            s.path_len++;
+        }
+
+        // Loop until the current integer is less that the starting point - in other words once the orbit converges
+        while ( current > start_mag );
+    }
+
+    s.max_int = static_cast< P >( largest );
+    s.class_factors = s.path_factors + std::countr_zero( current );
+}
+
+#ifdef gnu_mp
+
+/**
+ * @brief In-place GMP kernel for setpath() on positive multiple precision integers under the standard 3n+1 connection
+ * @details This is the multiple precision counterpart of setpath_ctz() and produces exactly the same orbit, maximum integer and
+ * factor counts as the generic setpath() loop.  The generic loop builds mpz_class temporaries for every connection in
+ * safe_arith<mpz_class> and every % and / in factor(), so long orbits of very large integers spend most of their time in the
+ * GMP allocator rather than doing arithmetic.
+ * 
+ * Here the orbit is walked in a single scratch register which is reused from one call to the next, so once its limbs have grown
+ * to fit the largest integer seen no further allocation takes place.  The connection is done with mpz_mul_ui() and mpz_add_ui()
+ * in place, the factors of 2 on a downleg are counted with mpz_scan1(), and mpz_sizeinbase() gives the difference in bit widths
+ * which locates the convergence point just as std::bit_width() does for built-in integers.
+ * @tparam P - The integer data type.  Must be mpz_class.
+ * @tparam M - The Collatz map policy.
+ * @param [in] start - The positive initial integer to find the convergent flow for.
+ * @param [in] max_factors - Upper limit on the number of factors of 2 in the path when in speed mode.
+ */
+template < class P, class M >
+void t_path< P, M >::setpath_mpz( const P &start, int max_factors )
+{
+    // Scratch register whose limbs persist between calls
+    static thread_local mpz_class scratch;
+    mpz_ptr current = scratch.get_mpz_t();
+
+    mpz_srcptr start_mpz = start.get_mpz_t();
+    mpz_ptr largest = max_int.get_mpz_t();
+
+    // Clear any existing state and initialize to the start value
+    init( start );
+
+    const long start_width = mpz_sizeinbase( start_mpz, 2 );
+
+    mpz_set( current, start_mpz );
+    mpz_set( largest, start_mpz );
+
+    // Optional jump table used to advance several downlegs at a time whenever that is certain to be exact
+    const jump_table *jumps = jump_table::select( statics::jump_bits );
+
+    // Eliminate the even numbers first, they converge immediately with a single factor of 2
+    if ( mpz_even_p( current ) )
+    {
+        orb.append( 1 );
+        path_factors++;
+    }
+
+    // Otherwise its odd, diverges and you need to figure out how it converges
+    else
+    {
+        orb.append( 0 );
+
+        do
+        {
+            // Jump while the orbit is far enough above the start to not converge and far enough below the largest integer so
+            // far to not set a new one
+            while ( jumps )
+            {
+                const jump_entry &e = jumps -> entry( mpz_getlimbn( current, 0 ) );
+                long width = mpz_sizeinbase( current, 2 );
+
+                if ( e.odd == 0 || width <= start_width + e.drop
+                                || width + e.growth >= static_cast< long >( mpz_sizeinbase( largest, 2 ) ) )
+                    break;
+
+                mpz_mul_ui( current, current, jumps -> power( e.odd ) );
+                mpz_add_ui( current, current, e.addend );
+                mpz_tdiv_q_2exp( current, current, e.steps );
+
+                // Append the downlegs just as they would have been had they been taken one at a time
+                const uint8_t *legs = jumps -> legs( e );
+
+                for ( int i = 0; i < e.odd; i++ )
+                {
+                    path_factors += legs[ i ];
+
+                    if ( statics::speed && ( path_factors > max_factors ) )
+                        return;
+
+                    orb.append( legs[ i ] );
+                }
+            }
+
+            mpz_mul_ui( current, current, 3 );
+            mpz_add_ui( current, current, 1 );
+
+            // Record the largest integer achieved during convergent segment
+            if ( mpz_cmp( current, largest ) > 0 )
+                mpz_set( largest, current );
+
+            // All of the factors of 2 available on this downleg
+            long zeros = mpz_scan1( current, 0 );
+
+            // Fewest divisions which could bring the branch below the start, limited to the factors of 2 available
+            long leg = static_cast< long >( mpz_sizeinbase( current, 2 ) ) - start_width;
+
+            if ( leg < 1 )
+                leg = 1;
+
+            if ( leg > zeros )
+                leg = zeros;
+
+            mpz_tdiv_q_2exp( current, current, leg );
+
+            // One more division if that was not quite enough and there is a factor of 2 left to take
+            if ( leg < zeros && mpz_cmp( current, start_mpz ) >= 0 )
+            {
+                mpz_tdiv_q_2exp( current, current, 1 );
+                leg++;
+            }
+
+            path_factors += leg;
+
+            // Abort the complete object creation process if the current number of path factors is greater than the target
+            if ( statics::speed && ( path_factors > max_factors ) )
+                return;
+
+            orb.append( leg );
+        }
+
+        // Loop until the current integer is less that the starting point - in other words once the orbit converges
+        while ( mpz_cmp( current, start_mpz ) > 0 );
+    }
+
+    // At a minimum the equivalence factors is the same as the path factors plus any residual factors of 2 in the remainder
+    ec_factors = path_factors + mpz_scan1( current, 0 );
+
+    // Clean up any factors of 2 from the starting integer and find the number of factors of 2 to get to the next local terminus
+    mpz_tdiv_q_2exp( current, start_mpz, mpz_scan1( start_mpz, 0 ) );
+    mpz_mul_ui( current, current, 3 );
+    mpz_add_ui( current, current, 1 );
+
+    next_factors = mpz_scan1( current, 0 );
+}
+
+/**
+ * @brief In-place GMP kernel for stats() on positive multiple precision integers under the standard 3n+1 connection
+ * @details This is setpath_mpz() with everything but the running totals taken out.  The orbit is walked in a scratch register
+ * which is reused from one call to the next, so the only allocation is for the maximum integer handed back to the caller.
+ * @tparam P - The integer data type.  Must be mpz_class.
+ * @tparam M - The Collatz map policy.
+ * @param [in] start - The positive initial integer to find the convergent flow for.
+ * @param [out] s - The statistics which are filled in.
+ */
+template < class P, class M >
+void t_path< P, M >::stats_mpz( const P &start, t_path_stats< P > &s )
+{
+    // Scratch register whose limbs persist between calls
+    static thread_local mpz_class scratch;
+    mpz_ptr current = scratch.get_mpz_t();
+
+    mpz_srcptr start_mpz = start.get_mpz_t();
+    mpz_ptr largest = s.max_int.get_mpz_t();
+
+    const long start_width = mpz_sizeinbase( start_mpz, 2 );
+
+    mpz_set( current, start_mpz );
+
+    // Even numbers converge immediately with a single factor of 2, the rest diverge until they converge
+    if ( mpz_even_p( current ) )
+        s.path_factors++;
+
+    else
+    {
+        do
+        {
+            mpz_mul_ui( current, current, 3 );
+            mpz_add_ui( current, current, 1 );
+
+            if ( mpz_cmp( current, largest ) > 0 )
+                mpz_set( largest, current );
+
+            // Fewest divisions which bring the branch below the start, limited to the factors of 2 available
+            long zeros = mpz_scan1( current, 0 );
+            long leg = static_cast< long >( mpz_sizeinbase( current, 2 ) ) - start_width;
+
+            if ( leg < 1 )
+                leg = 1;
+
+            if ( leg > zeros )
+                leg = zeros;
+
+            mpz_tdiv_q_2exp( current, current, leg );
+
+            // One more division if that was not quite enough and there is a factor of 2 left to take
+            if ( leg < zeros && mpz_cmp( current, start_mpz ) >= 0 )
+            {
+                mpz_tdiv_q_2exp( current, current, 1 );
+                leg++;
+            }
+
+            s.path_factors += leg;
+            s.path_len++;
+        }
+
+        // Loop until the current integer is less that the starting point - in other words once the orbit converges
+        while ( mpz_cmp( current, start_mpz ) > 0 );
+    }
+
+    s.class_factors = s.path_factors + mpz_scan1( current, 0 );
+}
+
+#endif
+
 /**
  * @brief Determine the minimum number of digits in the equivalence flow representation
  * @details The process finds the minimum length equivalence class for a given integer
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] start - The starting integer.  Segment convergence happens when the current integer in the sequence drops in 
  * magnitutde below this point. 
  * @return long - Return the minimum convergence class representation length.
  */
-template < class P >
-long t_path< P >::set_ec( const P &start )
+template < class P, class M >
+long t_path< P, M >::set_ec( const P &start )
 {
     // Compute the initial residual
-    P residual = start / statics::multiplier;
+    P residual = start / M::multiplier();
 
     // Always at least length one
     ec_len=1;
@@ -1379,7 +2177,7 @@ long t_path< P >::set_ec( const P &start )
     // Loop until you hit the global terminus
     while ( abs( residual ) > 1 )
     {
-        residual /= statics::divisor;
+        residual /= M::divisor();
         ec_len++;
     }
 
@@ -1390,11 +2188,12 @@ long t_path< P >::set_ec( const P &start )
  * @brief Simple function which sets the length of an equivalnce class to the string lenght minus any polarity indications
  * 
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] input - The input string representation of an equivalence class.
  * @return long - The length of the equivalence class excluding any sign (polarity) indications.
  */
-template < class P >
-long t_path< P >::get_ec_len( const std::string &input ) const
+template < class P, class M >
+long t_path< P, M >::get_ec_len( const std::string &input ) const
 {
     long len = input.length();
 
@@ -1409,12 +2208,13 @@ long t_path< P >::get_ec_len( const std::string &input ) const
  * @brief Indicates if an equivalenc class string includes a sign indication
  * 
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] input - Const reference to the input string.
  * @return true - The string includes a sign indication.
  * @return false - The string does not carry a sign indication.  This is taken to be positive.
  */
-template < class P >
-bool t_path< P >::is_signed( const std::string &input ) const
+template < class P, class M >
+bool t_path< P, M >::is_signed( const std::string &input ) const
 {
     char ch = input[0];         // Grab the first character
     return ( ch == '+' || ch == '-' );
@@ -1424,10 +2224,11 @@ bool t_path< P >::is_signed( const std::string &input ) const
  * @brief Initialize the class.  If there is any existing state it is first cleared.
  * 
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  * @param [in] start - The new starting integer for the path object.
  */
-template < class P >
-void t_path< P >::init( P start )
+template < class P, class M >
+void t_path< P, M >::init( const P &start )
 {
     // Clear current state and free memory if needed
     zeroize();
@@ -1449,9 +2250,10 @@ void t_path< P >::init( P start )
  * @brief Quite literally sets everything in the class object to 0.
  * 
  * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
  */
-template < class P >
-void t_path< P >::zeroize()
+template < class P, class M >
+void t_path< P, M >::zeroize()
 {
     // Clear state of integer member variables
     start_int = max_int = int_sign = path_factors = ec_factors = next_factors = ec_len = error_mask = 0;
@@ -1463,10 +2265,10 @@ void t_path< P >::zeroize()
 
 // Implementation specific int64_t functions in support of path template instantiation
 
-void pathPrint( const int64_t &start, long length, long factors, int indent, std::string flow, int max_digits )
+void pathPrint( const int64_t &start, long length, long factors, int indent, const char *flow, int max_digits, int multiplier )
 {
     printf( "%*" PRId64 ": (%02ld,%d*2^%03ld):%*c%s\n",
-            max_digits, start, length, statics::multiplier, factors, indent, ' ', flow.c_str() );
+            max_digits, start, length, multiplier, factors, indent, ' ', flow );
 }
 
 std::string to_str( const int64_t &remainder )
@@ -1475,20 +2277,813 @@ std::string to_str( const int64_t &remainder )
 }
 
 
-#ifdef gnu_mp
+#ifdef gnu_int128
 
-// Implementation specific mpz_class functions in support of mp_path template instantiation
+// Implementation specific int128_t and uint128_t functions in support of path128 and upath128 template instantiations
 
-void pathPrint( const mpz_class &start, long length, long factors, int indent, std::string flow, int max_digits )
+void pathPrint( const int128_t &start, long length, long factors, int indent, const char *flow, int max_digits, int multiplier )
 {
-    // The GNU multiple precision implementation extends the printf() functionality
-    gmp_printf( "%*Zd: (%02ld,%ld*2^%03ld):%*c%s\n",
-            max_digits, start.get_mpz_t(), length, statics::multiplier, factors, indent, ' ', flow.c_str() );
+    printf( "%*s: (%02ld,%d*2^%03ld):%*c%s\n",
+            max_digits, to_str( start ).c_str(), length, multiplier, factors, indent, ' ', flow );
 }
 
-std::string to_str( const mpz_class &remainder )
+void pathPrint( const uint128_t &start, long length, long factors, int indent, const char *flow, int max_digits, int multiplier )
 {
-    return remainder.get_str();
+    printf( "%*s: (%02ld,%d*2^%03ld):%*c%s\n",
+            max_digits, to_str( start ).c_str(), length, multiplier, factors, indent, ' ', flow );
+}
+
+std::string to_str( const uint128_t &remainder )
+{
+    char digits[ 40 ];                  // 2^128 has 39 decimal digits
+    char *pos = digits + sizeof( digits );
+    uint128_t value = remainder;
+
+    // Peel off the decimal digits from least to most significant
+    do
+    {
+        *--pos = '0' + static_cast< int >( value % 10 );
+        value /= 10;
+    }
+    while ( value != 0 );
+
+    return std::string( pos, digits + sizeof( digits ) );
+}
+
+std::string to_str( const int128_t &remainder )
+{
+    // Work with the unsigned magnitude so that the most negative value is also represented correctly
+    uint128_t magnitude = static_cast< uint128_t >( remainder );
+
+    if ( remainder < 0 )
+        return '-' + to_str( static_cast< uint128_t >( -magnitude ) );
+
+    return to_str( magnitude );
+}
+
+std::ostream &operator << ( std::ostream &os, const int128_t &integer )
+{
+    return os << to_str( integer );
+}
+
+std::ostream &operator << ( std::ostream &os, const uint128_t &integer )
+{
+    return os << to_str( integer );
+}
+
+/**
+ * @brief Parse an optionally signed decimal token into a 128-bit magnitude
+ * @param [in] is - The input stream to read the whitespace delimited token from.
+ * @param [out] negative - Set to true if the token carried a leading minus sign.
+ * @param [out] magnitude - The unsigned magnitude of the token.
+ * @return true - The token was a valid decimal integer which fits in 128 bits.
+ * @return false - The token was malformed or too large, in which case the failbit is set on the stream.
+ */
+static bool read_int128( std::istream &is, bool &negative, uint128_t &magnitude )
+{
+    std::string token;
+    negative = false;
+    magnitude = 0;
+
+    if ( !( is >> token ) )
+        return false;
+
+    size_t pos = 0;
+
+    // Accept an optional leading sign indicator
+    if ( token[ 0 ] == '+' || token[ 0 ] == '-' )
+    {
+        negative = ( token[ 0 ] == '-' );
+        pos++;
+    }
+
+    // There must be at least one digit, and every remaining character must be a digit which does not overflow
+    bool valid = ( pos < token.length() );
+
+    for ( ; valid && pos < token.length(); ++pos )
+    {
+        char ch = token[ pos ];
+
+        if ( ch < '0' || ch > '9' ||
+             __builtin_mul_overflow( magnitude, 10, &magnitude ) ||
+             __builtin_add_overflow( magnitude, ch - '0', &magnitude ) )
+            valid = false;
+    }
+
+    if ( !valid )
+        is.setstate( std::ios::failbit );
+
+    return valid;
+}
+
+std::istream &operator >> ( std::istream &is, int128_t &integer )
+{
+    bool negative;
+    uint128_t magnitude;
+
+    if ( read_int128( is, negative, magnitude ) )
+    {
+        // The most negative value has a magnitude one larger than the most positive
+        const uint128_t limit = static_cast< uint128_t >( std::numeric_limits< int128_t >::max() ) + ( negative ? 1 : 0 );
+
+        if ( magnitude > limit )
+            is.setstate( std::ios::failbit );
+        else
+            integer = negative ? static_cast< int128_t >( -magnitude ) : static_cast< int128_t >( magnitude );
+    }
+
+    return is;
+}
+
+std::istream &operator >> ( std::istream &is, uint128_t &integer )
+{
+    bool negative;
+    uint128_t magnitude;
+
+    if ( read_int128( is, negative, magnitude ) )
+    {
+        // A negative integer has no unsigned representation
+        if ( negative && magnitude != 0 )
+            is.setstate( std::ios::failbit );
+        else
+            integer = magnitude;
+    }
+
+    return is;
+}
+
+#endif
+
+
+#ifdef gnu_mp
+
+// Implementation specific mpz_class functions in support of mp_path template instantiation
+
+void pathPrint( const mpz_class &start, long length, long factors, int indent, const char *flow, int max_digits, int multiplier )
+{
+    // The GNU multiple precision implementation extends the printf() functionality
+    gmp_printf( "%*Zd: (%02ld,%d*2^%03ld):%*c%s\n",
+            max_digits, start.get_mpz_t(), length, multiplier, factors, indent, ' ', flow );
+}
+
+std::string to_str( const mpz_class &remainder )
+{
+    return remainder.get_str();
+}
+
+#endif
+
+#ifdef gnu_mp
+
+// adaptive_path implementations
+
+#ifdef gnu_int128
+
+/**
+ * @brief Convert a multiple precision integer to a native 128-bit integer if it fits
+ * @param [in] integer - The multiple precision integer to convert.
+ * @param [out] result - The converted value, unchanged if the integer does not fit.
+ * @return true - The integer was representable as an int128_t.
+ * @return false - The integer was too large in magnitude.
+ */
+static bool mpz_to_int128( const mpz_class &integer, int128_t &result )
+{
+    // Keep one bit of headroom so that the magnitude is always representable
+    if ( mpz_sizeinbase( integer.get_mpz_t(), 2 ) > 126 )
+        return false;
+
+    uint64_t words[ 2 ] = { 0, 0 };
+    mpz_export( words, nullptr, -1, sizeof( uint64_t ), 0, 0, integer.get_mpz_t() );
+
+    int128_t magnitude = ( static_cast< int128_t >( words[ 1 ] ) << 64 ) | words[ 0 ];
+    result = ( sgn( integer ) < 0 ) ? -magnitude : magnitude;
+
+    return true;
+}
+
+/**
+ * @brief Convert a native 128-bit integer to a multiple precision integer
+ * @param [in] integer - The 128-bit integer to convert.
+ * @return mpz_class - The exact multiple precision equivalent.
+ */
+static mpz_class int128_to_mpz( const int128_t &integer )
+{
+    uint128_t magnitude = ( integer < 0 ) ? -static_cast< uint128_t >( integer ) : static_cast< uint128_t >( integer );
+    uint64_t words[ 2 ] = { static_cast< uint64_t >( magnitude ), static_cast< uint64_t >( magnitude >> 64 ) };
+
+    mpz_class result;
+    mpz_import( result.get_mpz_t(), 2, -1, sizeof( uint64_t ), 0, 0, words );
+
+    if ( integer < 0 )
+        result = -result;
+
+    return result;
+}
+
+#endif
+
+/**
+ * @brief Convert the integer held by any of the path types to a multiple precision integer
+ * @tparam I - The integer type of the path object holding the orbit.
+ * @param [in] integer - The integer to convert.
+ * @return mpz_class - The exact multiple precision equivalent.
+ */
+template < class I >
+static mpz_class adaptive_to_mpz( const I &integer )
+{
+#ifdef gnu_int128
+    if constexpr ( std::is_same< I, int128_t >::value )
+        return int128_to_mpz( integer );
+    else
+#endif
+    if constexpr ( std::is_same< I, mpz_class >::value )
+        return integer;
+    else
+        return mpz_class( static_cast< long >( integer ) );
+}
+
+/**
+ * @brief Default constructor for a new adaptive_path object
+ * @details The orbit starts out as a default constructed standard precision path.
+ */
+adaptive_path::adaptive_path()
+{
+}
+
+/**
+ * @brief Constructor for a new adaptive_path object given an integer
+ * @details Calculates the path using 64-bit integers and promotes this orbit only if a connection overflows.
+ * @param [in] start - The starting integer.
+ */
+adaptive_path::adaptive_path( const int64_t &start )
+{
+    build( start, false, 0 );
+}
+
+/**
+ * @brief Constructor for a new adaptive_path object given an integer and an equivalence class length
+ * @param [in] start - The starting integer.
+ * @param [in] class_len - The specified equivalence class length.
+ */
+adaptive_path::adaptive_path( const int64_t &start, long class_len )
+{
+    build( start, true, class_len );
+}
+
+/**
+ * @brief Constructor for a new adaptive_path object given a multiple precision integer
+ * @details The orbit begins with the narrowest type able to hold the starting integer.
+ * @param [in] start - The starting integer.
+ */
+adaptive_path::adaptive_path( const mpz_class &start )
+{
+    build( start, false, 0 );
+}
+
+/**
+ * @brief Constructor for a new adaptive_path object given a multiple precision integer and an equivalence class length
+ * @param [in] start - The starting integer.
+ * @param [in] class_len - The specified equivalence class length.
+ */
+adaptive_path::adaptive_path( const mpz_class &start, long class_len )
+{
+    build( start, true, class_len );
+}
+
+/**
+ * @brief Constructor for a new adaptive_path object given its equivalence class string representation
+ * @param [in] input - Const reference to an equivalence class std::string representation.
+ */
+adaptive_path::adaptive_path( const std::string &input )
+{
+    build( input );
+}
+
+/**
+ * @brief Constructor for a new adaptive_path object given its equivalence class character array representation
+ * @param [in] input - Const reference to an equivalence class character array representation.
+ */
+adaptive_path::adaptive_path( const char input[] )
+{
+    build( std::string( input ) );
+}
+
+/**
+ * @brief Retrieve the path as a std::string object (e.g. 0 1 2 1 2 1 3)
+ * @return std::string - Returns the path by calling the orbit::path() function.
+ */
+std::string adaptive_path::getpath() const
+{
+    return std::visit( []( const auto &p ) { return p.getpath(); }, tier );
+}
+
+/**
+ * @brief Return the equivalence class representation
+ * @param [in] digits - Desired nubmer of digits in the representation.  Defaults to -1 which is a signal to use the standard class length.
+ * @return std::string - Return the flow representation in signed hex binary notation.
+ * @see t_path::flow()
+ */
+std::string adaptive_path::flow( long digits ) const
+{
+    return std::visit( [ digits ]( const auto &p ) { return p.flow( digits ); }, tier );
+}
+
+/**
+ * @brief Determines the next parent integer of the starting integer
+ * @details The search for parents multiplies the starting integer by an increasing scale, so even a modest starting integer can
+ * overflow along the way.  When that happens the search is repeated with multiple precision integers.
+ * @param [out] scale - The scale from which to resume the search, returned as the scale of the parent found.
+ * @return mpz_class - Returns the parent integer, or 0 if no parents are possible.
+ * @see t_path::ancestry()
+ */
+mpz_class adaptive_path::ancestry( long &scale ) const
+{
+    long resume = scale;
+
+    try
+    {
+        return std::visit( [ &scale ]( const auto &p ) { return adaptive_to_mpz( p.ancestry( scale ) ); }, tier );
+    }
+    catch ( const std::overflow_error & )
+    {
+        scale = resume;
+        return mp_path( start() ).ancestry( scale );
+    }
+}
+
+/**
+ * @brief Return the next integer in an orbit
+ * @details The 3n+1 connection of the starting integer is computed with multiple precision integers if it overflows.
+ * @return mpz_class - The next integer in the orbit.
+ * @see t_path::next()
+ */
+mpz_class adaptive_path::next() const
+{
+    try
+    {
+        return std::visit( []( const auto &p ) { return adaptive_to_mpz( p.next() ); }, tier );
+    }
+    catch ( const std::overflow_error & )
+    {
+        return mp_path( start() ).next();
+    }
+}
+
+/**
+ * @brief Return the starting integer
+ * @return mpz_class - The staring integer.
+ */
+mpz_class adaptive_path::start() const
+{
+    return std::visit( []( const auto &p ) { return adaptive_to_mpz( p.start() ); }, tier );
+}
+
+/**
+ * @brief The maximum integer visited during a convergent segment.
+ * @return mpz_class - The maximum integer in the convergence segment.
+ */
+mpz_class adaptive_path::max() const
+{
+    return std::visit( []( const auto &p ) { return adaptive_to_mpz( p.max() ); }, tier );
+}
+
+/**
+ * @brief Returns the orbit.
+ * @return const orbit_t& - Return a const reference to the orbit object of whichever type holds it.
+ */
+const orbit_t& adaptive_path::orbit() const
+{
+    return std::visit( []( const auto &p ) -> const orbit_t& { return p.orbit(); }, tier );
+}
+
+/**
+ * @brief Return the sign of the integer
+ * @return int - Sign of the integer.
+ */
+int adaptive_path::sign() const
+{
+    return std::visit( []( const auto &p ) { return p.sign(); }, tier );
+}
+
+/**
+ * @brief Error code
+ * @return int - Error code.  Overflow errors are not expected since they trigger promotion instead.
+ */
+int adaptive_path::error() const
+{
+    return std::visit( []( const auto &p ) { return p.error(); }, tier );
+}
+
+/**
+ * @brief The precision which was needed to represent the orbit
+ * @return int - The number of bits in the integer type holding the orbit, or 0 for multiple precision.
+ */
+int adaptive_path::precision() const
+{
+    return std::visit( []( const auto &p )
+                       {
+                           if constexpr ( std::is_same< std::decay_t< decltype( p ) >, mp_path >::value )
+                               return 0;
+                           else
+                               return static_cast< int >( 8 * sizeof( p.start() ) );
+                       }, tier );
+}
+
+/**
+ * @brief Return the number if downlegs in the orbit.
+ * @return long - The number of downlegs (3n+1 connections) in the convergent orbit.
+ */
+long adaptive_path::pathLength() const
+{
+    return std::visit( []( const auto &p ) { return p.pathLength(); }, tier );
+}
+
+/**
+ * @brief The length of the equivalence class
+ * @return long - The number of digits in the equivalence class representation.
+ */
+long adaptive_path::classLength() const
+{
+    return std::visit( []( const auto &p ) { return p.classLength(); }, tier );
+}
+
+/**
+ * @brief The aggregate number of factors of 2 in the orbit
+ * @return long - Total factors of 2 from the entire convergent orbit
+ */
+long adaptive_path::pathFactors() const
+{
+    return std::visit( []( const auto &p ) { return p.pathFactors(); }, tier );
+}
+
+/**
+ * @brief The number of factors of two common to the entire equivalence class for convergence.
+ * @return long - The total number of factors of 2 for the equivalence class to get to the convergent local terminus.
+ */
+long adaptive_path::classFactors() const
+{
+    return std::visit( []( const auto &p ) { return p.classFactors(); }, tier );
+}
+
+/**
+ * @brief Returns the number of factors of two after reaching the next local terminus in the orbit
+ * @return long - The number of factors of two following the next 3n+1 connection.
+ */
+long adaptive_path::nextFactors() const
+{
+    return std::visit( []( const auto &p ) { return p.nextFactors(); }, tier );
+}
+
+/**
+ * @brief Hash an adaptive_path by the fingerprint of its orbit
+ * @param [in] p - Const reference to the path object to hash.
+ * @return size_t - The fingerprint of the orbit.
+ */
+size_t std::hash< adaptive_path >::operator()( const adaptive_path &p ) const noexcept
+{
+    return p.orbit().fingerprint();
+}
+
+/**
+ * @brief Equivalency check
+ * @details Compares the orbits regardless of which integer type holds them.  Not this does \b not compare the starting integers.
+ * @param [in] rp - Const reference to the path object to compare to.
+ * @return true - The paths are equivalent
+ * @return false - The paths are different
+ */
+bool adaptive_path::operator == ( const adaptive_path &rp ) const
+{
+    // If the path lengths are unequal then its a no-brainer that they are not equal
+    if ( pathLength() != rp.pathLength() )
+        return false;
+
+    return orbit() == rp.orbit();
+}
+
+/**
+ * @brief Inequivalency check
+ * @param [in] rp - Const reference to the path object to compare to.
+ * @return true - The paths are different
+ * @return false - The paths are equivalent
+ */
+bool adaptive_path::operator != ( const adaptive_path &rp ) const
+{
+    return !( orbit() == rp.orbit() );
+}
+
+/**
+ * @brief Ordinal less than comparison
+ * @param [in] rp - Const reference to the path object to compare to.
+ * @return true - The path is less than the argument orbit
+ * @return false - The path is greater than or equal to the argument orbit
+ */
+bool adaptive_path::operator < ( const adaptive_path &rp ) const
+{
+    return orbit() < rp.orbit();
+}
+
+/**
+ * @brief Ordinal greater than comparison
+ * @param [in] rp - Const reference to the path object to compare to.
+ * @return true - The path is greater than the argument orbit
+ * @return false - The path is less than or equal to the argument orbit
+ */
+bool adaptive_path::operator > ( const adaptive_path &rp ) const
+{
+    return orbit() > rp.orbit();
+}
+
+/**
+ * @brief Ordinal less than or equal to comparison
+ * @param [in] rp - Const reference to the path object to compare to.
+ * @return true - The path is less than or equal to the argument orbit
+ * @return false - The path is greater than the argument orbit
+ */
+bool adaptive_path::operator <= ( const adaptive_path &rp ) const
+{
+    return !( orbit() > rp.orbit() );
+}
+
+/**
+ * @brief Ordinal greater than or equal to comparison
+ * @param [in] rp - Const reference to the path object to compare to.
+ * @return true - The path is greater than or equal to the argument orbit
+ * @return false - The path is less than the argument orbit
+ */
+bool adaptive_path::operator >= ( const adaptive_path &rp ) const
+{
+    return !( orbit() < rp.orbit() );
+}
+
+/**
+ * @brief Print out the equivalence class in its nominal form.
+ * @see t_path::prettyPrint()
+ */
+void adaptive_path::prettyPrint() const
+{
+    std::visit( []( const auto &p ) { p.prettyPrint(); }, tier );
+}
+
+/**
+ * @brief Print out the equivalence class whose length is limited to the \b total number of factors of 2
+ * @see t_path::prettyPrintClass()
+ */
+void adaptive_path::prettyPrintClass() const
+{
+    std::visit( []( const auto &p ) { p.prettyPrintClass(); }, tier );
+}
+
+/**
+ * @brief Print out the convergent orbit
+ * @see t_path::prettyPrintPath()
+ */
+void adaptive_path::prettyPrintPath() const
+{
+    std::visit( []( const auto &p ) { p.prettyPrintPath(); }, tier );
+}
+
+/**
+ * @brief Print out the equivalence class with first column width (the generating integer)
+ * @param [in] max_digits - The maximum number of base 10 digits in the first column (used for right justification).
+ */
+void adaptive_path::prettyPrint( int max_digits ) const
+{
+    std::visit( [ max_digits ]( const auto &p ) { p.prettyPrint( max_digits ); }, tier );
+}
+
+/**
+ * @brief Print out the equivalence class with first column width (the generating integer) equal to max_digits
+ * @param [in] len - Length of the convergence class for the convergent flow segment.
+ * @param [in] max_digits - The maximum number of base 10 digits in the first column (used for right justification).
+ */
+void adaptive_path::prettyPrint( long len, int max_digits ) const
+{
+    std::visit( [ len, max_digits ]( const auto &p ) { p.prettyPrint( len, max_digits ); }, tier );
+}
+
+/**
+ * @brief Print out the equivalence class with first column width equal to max_digits and fancy indenting
+ * @param [in] len - Length of the convergence class for the convergent flow segment.
+ * @param [in] indent - Indents the equivalnce class representation so convergent and divergent flows are visible.
+ * @param [in] max_digits - The maximum number of base 10 digits in the first column (used for right justification).
+ */
+void adaptive_path::prettyPrint( long len, long indent, int max_digits ) const
+{
+    std::visit( [ len, indent, max_digits ]( const auto &p ) { p.prettyPrint( len, indent, max_digits ); }, tier );
+}
+
+/**
+ * @brief Print out the equivalence class whose length is limited to the \b total number of factors of 2 required to converge
+ * @param [in] max_digits - The maximum number of base 10 digits in the first column (used for right justification).
+ */
+void adaptive_path::prettyPrintClass( int max_digits ) const
+{
+    std::visit( [ max_digits ]( const auto &p ) { p.prettyPrintClass( max_digits ); }, tier );
+}
+
+/**
+ * @brief Print out the convergent orbit
+ * @param [in] max_digits - The maximum number of base 10 digits in the first column (used for right justification).
+ */
+void adaptive_path::prettyPrintPath( int max_digits ) const
+{
+    std::visit( [ max_digits ]( const auto &p ) { p.prettyPrintPath( max_digits ); }, tier );
+}
+
+/**
+ * @brief Attempt to build the orbit using path type Q
+ * @details The safe_arith<P> checks throw std::overflow_error as soon as a connection cannot be represented, which is the
+ * signal to try again with a wider type.
+ * @tparam Q - The path type to attempt.
+ * @tparam I - The integer type of the starting integer, which must be convertible to the integer type of Q.
+ * @param [in] start - The starting integer.
+ * @param [in] classed - Whether or not an equivalence class length was specified.
+ * @param [in] class_len - The specified equivalence class length.
+ * @return true - The orbit was represented completely by Q.
+ * @return false - A connection overflowed.
+ */
+template < class Q, class I >
+bool adaptive_path::attempt( const I &start, bool classed, long class_len )
+{
+    try
+    {
+        if ( classed )
+            tier.emplace< Q >( start, class_len );
+        else
+            tier.emplace< Q >( start );
+    }
+    catch ( const std::overflow_error & )
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Attempt to build the orbit of an equivalence class using path type Q
+ * @details An equivalence class too long for type Q to parse is rejected up front.  The parse() member function doubles a
+ * multiplier of 6 for each digit after the first, so Q can parse at most as many digits as it has value bits, less two.
+ * @tparam Q - The path type to attempt.
+ * @param [in] input - Const reference to an equivalence class std::string representation.
+ * @return true - The orbit was represented completely by Q.
+ * @return false - The class was too long to parse or a connection overflowed.
+ */
+template < class Q >
+bool adaptive_path::attempt( const std::string &input )
+{
+    typedef decltype( Q().start() ) I;
+
+    if constexpr ( std::is_integral< I >::value )
+    {
+        long digits = input.length() - ( ( input[ 0 ] == '+' || input[ 0 ] == '-' ) ? 1 : 0 );
+
+        if ( digits > std::numeric_limits< I >::digits - 2 )
+            return false;
+    }
+
+    try
+    {
+        tier.emplace< Q >( input );
+    }
+    catch ( const std::overflow_error & )
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Build the orbit starting with 64-bit integers and promote as required
+ * @param [in] start - The starting integer.
+ * @param [in] classed - Whether or not an equivalence class length was specified.
+ * @param [in] class_len - The specified equivalence class length.
+ */
+void adaptive_path::build( const int64_t &start, bool classed, long class_len )
+{
+    if ( attempt< path >( start, classed, class_len ) )
+        return;
+
+#ifdef gnu_int128
+    if ( attempt< path128 >( static_cast< int128_t >( start ), classed, class_len ) )
+        return;
+#endif
+
+    attempt< mp_path >( mpz_class( static_cast< long >( start ) ), classed, class_len );
+}
+
+/**
+ * @brief Build the orbit starting with the narrowest type able to hold the starting integer and promote as required
+ * @param [in] start - The starting integer.
+ * @param [in] classed - Whether or not an equivalence class length was specified.
+ * @param [in] class_len - The specified equivalence class length.
+ */
+void adaptive_path::build( const mpz_class &start, bool classed, long class_len )
+{
+    if ( start.fits_slong_p() )
+        return build( static_cast< int64_t >( start.get_si() ), classed, class_len );
+
+#ifdef gnu_int128
+    int128_t wide_start;
+
+    if ( mpz_to_int128( start, wide_start ) && attempt< path128 >( wide_start, classed, class_len ) )
+        return;
+#endif
+
+    attempt< mp_path >( start, classed, class_len );
+}
+
+/**
+ * @brief Build the orbit of an equivalence class starting with 64-bit integers and promote as required
+ * @param [in] input - Const reference to an equivalence class std::string representation.
+ */
+void adaptive_path::build( const std::string &input )
+{
+    if ( attempt< path >( input ) )
+        return;
+
+#ifdef gnu_int128
+    if ( attempt< path128 >( input ) )
+        return;
+#endif
+
+    attempt< mp_path >( input );
+}
+
+/**
+ * @brief Attempt to compute the convergence statistics of an integer using path type Q
+ * @tparam Q - The path type to attempt.
+ * @tparam I - The integer type of the starting integer.
+ * @param [in] start - The starting integer.
+ * @param [out] s - The statistics converted to multiple precision integers if Q was wide enough.
+ * @return true - The orbit was represented completely by Q.
+ * @return false - A connection overflowed.
+ */
+template < class Q, class I >
+bool adaptive_path::attempt_stats( const I &start, mp_path_stats &s )
+{
+    try
+    {
+        auto narrow = Q::stats( start );
+
+        s.path_len = narrow.path_len;
+        s.path_factors = narrow.path_factors;
+        s.class_factors = narrow.class_factors;
+        s.max_int = adaptive_to_mpz( narrow.max_int );
+        s.error_mask = narrow.error_mask;
+    }
+    catch ( const std::overflow_error & )
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Compute the convergence statistics of an integer starting with 64-bit integers and promote as required
+ * @details The same promotion as the constructors, but using t_path< P >::stats() so that no orbit is recorded at any tier.
+ * @param [in] start - The starting integer.
+ * @return mp_path_stats - The statistics with the maximum integer as a multiple precision integer.
+ */
+mp_path_stats adaptive_path::stats( const int64_t &start )
+{
+    mp_path_stats s;
+
+    if ( attempt_stats< path >( start, s ) )
+        return s;
+
+#ifdef gnu_int128
+    if ( attempt_stats< path128 >( static_cast< int128_t >( start ), s ) )
+        return s;
+#endif
+
+    attempt_stats< mp_path >( mpz_class( static_cast< long >( start ) ), s );
+    return s;
+}
+
+/**
+ * @brief Compute the convergence statistics of an integer starting with the narrowest type able to hold it
+ * @param [in] start - The starting integer.
+ * @return mp_path_stats - The statistics with the maximum integer as a multiple precision integer.
+ */
+mp_path_stats adaptive_path::stats( const mpz_class &start )
+{
+    if ( start.fits_slong_p() )
+        return stats( static_cast< int64_t >( start.get_si() ) );
+
+    mp_path_stats s;
+
+#ifdef gnu_int128
+    int128_t wide_start;
+
+    if ( mpz_to_int128( start, wide_start ) && attempt_stats< path128 >( wide_start, s ) )
+        return s;
+#endif
+
+    attempt_stats< mp_path >( start, s );
+    return s;
 }
 
-#endif
\ No newline at end of file
+#endif
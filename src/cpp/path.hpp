@@ -13,138 +13,294 @@
 #pragma once
 #include "common.hpp"
 #include "safe_arith.hpp"
+#include "jump.hpp"
+#include "arena.hpp"
 #include <bit>
+#include <variant>
+#include <limits>
+#include <algorithm>
+#include <iterator>
 
 /**
- * @brief This constexpr function returns the correct orbit index based on the endianness of the host system.
- * @details Because the orbit_key_t union uses an array of 8-bit unsigned integers to represent orbit elements
- * the order of these elements in memory depends on the endianness of the host system.  This function abstracts
- * away that detail by returning the correct index for accessing the orbit elements in a way that is independent
- * of the underlying system architecture.
- * 
- * @param logical - The logical index (0 to 7) representing the position of the orbit element.
- * @return size_t - The physical index adjusted for system endianness.
- */
-constexpr size_t orbit_index(size_t logical)
-{
-    if constexpr (std::endian::native == std::endian::little)
-        return logical;
-    else
-        return 7 - logical;
-}
-
-/**
- * @brief The union orbit_key_t provides both an 8-element array of 8-bit unsigned integers and a 64-bit unsigned
- * integer representation.
- * 
- * As a result of this design, both parts are composed of the same number of bits (64) and the union structure itself can be used
- * either way as is most convenient.  However this introduces a scaling limit of the orbit_key_t orbital path representation.
- * 
- * Each unsigned 8-bit integer element in the array represents the number of divisor factors of 2 in the orbit element. A path is
- * represented by a series of these orbit elements.  Typically, each orbit element consists of small number (most often 1 or 2)
- * as this value represents the factors of 2 which are divisible following a 3n+1 Collatz Connection.  Put another way, if 2^k
- * is the maximum divisible power of 2 following a Connection then \e k is the value stored in the 8-element array of 8-bit
- * unsigned integers. But because it is stored as an 8-bit unsigned integer it is unable to represent more than 255 powers of 2 -
- * which could affect the representation of orbits for integers, \b n, larger than:
- * 
- * \f[ n = 2^{256} > 10^{77}; n \in \mathbf{N} \f]
- * 
- * For the intended purpose this limit is sufficiently distant to not impact the empirical validation of the proposed proof.  However,
- * if this limit proves too restrictive for other investigations you can increase the scale dramatically by storing the exponent of 2
- * as a 16-bit unsigned integer (uint16_t) at the cost of some additional memory and CPU for storing larger exponents and generating
- * longer linked lists for orbits consisting of more than 4 elements.
- * 
- * Using a 16-bit unsigned exponent representation would create a much higher orbit path element representation limit
- * for integers, \b n, larger than:
- * 
- * \f[ n = (2^{256})^2 = 2^{512}> 10^{154}; n \in \mathbf{N} \f]
- * 
- * Thus the orbit_t union holds the \b binary orbit path element represention - but this can also be interpreted as a single 64-bit
- * unsigned integer which is very useful for performing efficient key value comparison and assignment operations.
+ * @brief The union orbit_key_t packs sixteen 4-bit orbit element codes into a 64-bit unsigned integer.
+ * @details Each orbit element is the number of divisor factors of 2 which follow a 3n+1 Collatz Connection.  Put another way, if
+ * 2^k is the maximum divisible power of 2 following a Connection then \e k is the orbit element.  Typically, each orbit element
+ * is a small number (most often 1 or 2), so it is stored as a single 4-bit code whenever it is less than 15.  Larger elements are
+ * stored as the escape code 15, followed by a code holding the number of 4-bit digits in the element, followed by the digits
+ * themselves, most significant digit first and without leading zeros.  So 15 is stored as F 1 F and 255 as F 2 F F, and the
+ * largest element which can be stored has 15 digits, which is 2^60 - 1.  An integer would need 2^60 factors of 2 to reach that
+ * limit, so in practice any orbit can be stored.  The \ref t_orbit template narrows the limit to the element width chosen by
+ * each path type.
+ *
+ * The codes fill each union starting from the most significant 4 bits, and every code which is not in use is zero.  Since an
+ * element below 15 has a smaller code than the escape code, and escaped elements are compared first by their number of digits
+ * and then digit by digit, comparing two orbits as a sequence of 64-bit unsigned integers orders them lexicographically by their elements.  Using shifts rather than
+ * byte addressing also keeps the layout the same on any host regardless of endianness.
  */
 union orbit_key_t
 {
-    uint64_t    i_key;                                                  /**< The unsigned 64-bit representation for ordinality checks. */
-    uint8_t     c_key[ sizeof( uint64_t ) ];                            /**< Array of 8-bit uints each of which is an orbit element. */
+    uint64_t    i_key;                                                  /**< The unsigned 64-bit representation holding 16 codes. */
 };
 
+struct orbit_view;
 
 /**
- * @brief This struct leverages the orbit_key_t union as nodes of a linked list to create orbital paths of arbitrary length.
- * @details This node is an element of a singly linked list (no back pointers) since all orbital paths are unidrectional in nature
- * and there are no meaningful semantics to a backward traversal of the orbit.
- * This struct also introduces convenient ordinal comparison operators which utilize the 64-bit unsigned integer representation
- * of the orbit_key_t union for fast and efficient integer comparison between unions.
- * 
- * The decision was made to create an entirely public implementation limiting the member functions to ones furnishing notational
- * conveniences (i.e. operators) and initialization rather than one with an excessive number of member functions since orbit_node_t
- * will itself become encapsulated in the orbit_t struct.  The orbit_t linked list struct will in turm become a protected member
- * within the larger context of the templated t_path< P > class inheritance tree.  Note that there is no explicit destructor for
- * this object as this task is handled more elegantly within the context of the orbit_t linked list struct.
- */
-struct orbit_node_t
-{
-    public:
-        orbit_node_t();
-        orbit_node_t( const orbit_node_t &o );              // Copy constructor
-
-        inline orbit_node_t &operator = ( const orbit_node_t &o );
-
-        bool operator == ( const orbit_node_t &o ) const;
-        bool operator <  ( const orbit_node_t &o ) const;
-        bool operator >  ( const orbit_node_t &o ) const;
-
-        void init();
-
-        orbit_key_t     key;                                            /**< A 64-bit union representing the orbit elements. */
-        orbit_node_t    *next;                                          /**< Pointer to the next union or nullptr. */
-};
-
-
-/**
- * @brief This struct implements the linked list orbital path of arbitrary length along with comparison operators in order compare
+ * @brief This struct implements the orbital path of arbitrary length along with comparison operators in order compare
  * the orbits of a pair of orbit_t objects.
- * @details The orbit_t struct utilizes orbit_node_t structs to create linked lists consisting of one or more nodes.
- * A linked list consisting of a single orbit_node_t struct can represent an orbit of up to 8 orbit elements.  Beyond length 8,
- * this struct allocates and links additional orbit_node_t objects as needed to represent the complete orbit.
- * If the root element next pointer is nullptr the list can hold up to the first 8 elements in the orbit.
- * If the node itself has a non-nullptr next entry then the number of orbit element extends beyond the root node.
- * In all cases the link list terminates where the orbit_node_t next pointer is nullptr.
- * The root node is allocated off of the stack and is thus deallocated automaticaally once the object goes out of scope.
- * Additional nodes in the linked list are allocated off of the heap and thus need to be explicitly allocated and freed.
+ * @details The orbit element codes are held in a contiguous array of orbit_key_t unions, each of which holds 16 codes.  The
+ * first inline_words unions are stored inside the object itself, so orbits of up to 48 elements never touch the heap.  Once an
+ * orbit grows beyond that, the whole array moves to a heap allocation which doubles in size as needed.  A copy only allocates as
+ * many unions as the orbit actually uses, which matters since long scans keep millions of orbit copies in their trees.
+ *
+ * If an arena is current when the orbit outgrows its inline unions the array is taken from the arena instead of the heap.
+ *
+ * Comparisons are made one 64-bit union at a time over the unions the two orbits have in common, with the path length breaking
+ * the tie when one orbit is a prefix of the other.  An orbit always holds at least the one union which an empty orbit compares as
+ * zero.
+ *
+ * Every append also folds the element into a 64-bit fingerprint of the orbit.  Orbits with different lengths or fingerprints
+ * are known to differ without comparing their unions, and the fingerprint doubles as the hash of the orbit.
  */
 struct orbit_t
 {
     public:
         orbit_t();
         orbit_t( const orbit_t &o );              // Copy constructor
+        orbit_t( orbit_t &&o ) noexcept;          // Move constructor
         ~orbit_t();
 
         std::string path() const;
+        inline orbit_view view() const;
+        inline long operator [] ( int index ) const;
+        size_t format( char *buffer, size_t size ) const;
         void append( const long divisors );
         inline int error() const;
         inline int path_len() const;
+        inline uint64_t fingerprint() const;
 
         orbit_t &operator = ( const orbit_t &ro );
+        orbit_t &operator = ( orbit_t &&ro ) noexcept;
 
         inline bool operator == ( const orbit_t &ro ) const;
         inline bool operator <  ( const orbit_t &ro ) const;
         inline bool operator >  ( const orbit_t &ro ) const;
 
         void clear();
-        
+
+        static const int inline_words = 3;                              /**< Number of orbit_key_t unions stored inline. */
+        static const int code_bits = 4;                                 /**< Number of bits in each element code. */
+        static const int word_codes = 64 / code_bits;                   /**< Number of element codes in each union. */
+        static const int escape = ( 1 << code_bits ) - 1;               /**< Code preceding an element too large for one code. */
+        static const int max_digits = escape;                           /**< Largest number of digits in an escaped element. */
+        static const uint64_t empty_hash = 0xcbf29ce484222325;         /**< Fingerprint of an empty orbit. */
+
     protected:
-        orbit_node_t *new_node();
+        inline int words() const;
+        inline int code( int index ) const;
+        static inline int code( const orbit_key_t *keys, int index );
+        inline void put_code( int value );
+        int compare( const orbit_t &ro ) const;
+        static int compare( const orbit_key_t *a, int a_codes, int a_length, const orbit_key_t *b, int b_codes, int b_length );
+        bool reserve( int count );
         void copy_list( const orbit_t &ro );
+        void move_list( orbit_t &ro );
         void free_list();
         inline void init();
 
-        orbit_node_t    root;                                           /**< The initial node of the orbit linked list */
-        orbit_node_t    *curr;                                          /**< A pointer to the current node to write to */
+        orbit_key_t     local[ inline_words ];                          /**< The inline unions holding the first orbit elements */
+        orbit_key_t     *keys;                                          /**< The unions in use, either local or on the heap */
+        int             capacity;                                       /**< The number of unions available at keys */
         int             path_length;                                    /**< The orbit path length */
+        int             code_length;                                    /**< The number of element codes in use */
+        uint64_t        hash_key;                                          /**< The fingerprint of the elements appended so far */
         int             error_mask;                                     /**< The error flag bitmask */
+        bool            pooled;                                         /**< The unions at keys belong to an arena */
+
+        friend class orbit_store;                                       // The store keeps and rebuilds orbits from their unions
+        friend struct orbit_view;                                       // The view decodes the unions in place
+};
+
+/**
+ * @brief A read only view of the elements of an orbit, in the manner of std::span over the packed unions
+ * @details The view neither owns nor copies the unions, so it is only valid while the orbit or store holding them is unchanged.
+ * Elements are decoded on the fly as they are read, so an orbit can be inspected or printed without building a std::string.
+ * Indexing is constant time when no element of the orbit needed an escape code, which is when the number of codes equals the
+ * path length, and otherwise walks the codes from the start.  The forward iterator always steps in constant time.
+ */
+struct orbit_view
+{
+    public:
+        /** @brief Forward iterator over the orbit elements which decodes each element as it is dereferenced */
+        class const_iterator
+        {
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef long value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef const long *pointer;
+                typedef long reference;
+
+                const_iterator() : keys( nullptr ), position( 0 ) {}
+                const_iterator( const orbit_key_t *k, int p ) : keys( k ), position( p ) {}
+
+                inline long operator * () const;
+                inline const_iterator &operator ++ ();
+                inline const_iterator operator ++ ( int );
+                bool operator == ( const const_iterator &ri ) const { return position == ri.position; }
+                bool operator != ( const const_iterator &ri ) const { return position != ri.position; }
+
+            protected:
+                const orbit_key_t *keys;                /**< The unions holding the codes. */
+                int position;                           /**< Index of the first code of the current element. */
+        };
+
+        orbit_view( const orbit_key_t *k, int codes, int length ) : keys( k ), code_length( codes ), path_length( length ) {}
+
+        inline const_iterator begin() const;
+        inline const_iterator end() const;
+        inline int size() const;
+        inline bool empty() const;
+        inline long operator [] ( int index ) const;
+
+        size_t format( char *buffer, size_t size ) const;
+        const char *text( char *buffer, size_t size, std::string &spill ) const;
+        std::string str() const;
+
+        static const size_t buffer_size = 1024;         /**< Stack buffer size which holds the text of most orbits. */
+
+    protected:
+        const orbit_key_t *keys;                        /**< The unions holding the codes. */
+        int code_length;                                /**< The number of element codes in use. */
+        int path_length;                                /**< The number of orbit elements. */
 };
 
+/**
+ * @brief An orbit_t in a tree with an arena takes its unions from that arena, so it can be released without its destructor
+ */
+template <>
+struct t_arena_release< orbit_t > : std::true_type {};
+
+/**
+ * @brief Hash of an orbit_t for use as a key in hashed containers, which is simply its fingerprint
+ */
+template <>
+struct std::hash< orbit_t >
+{
+    inline size_t operator()( const orbit_t &o ) const noexcept;
+};
+
+/**
+ * @brief The orbit of a path type whose elements are limited to the width of an unsigned integer type
+ * @details Every width shares the encoding of orbit_t, so orbits of different widths compare, copy and hash exactly as orbit_t
+ * objects do.  The width only sets the largest element append() accepts, which is the limit of the integer type or the 2^60 - 1
+ * limit of the encoding, whichever is smaller.  The limit is set by each path type through \ref t_orbit_element so that it is
+ * beyond the reach of any integer the path type can hold.
+ * @tparam E - The unsigned integer type of an orbit element (e.g. uint8_t, uint16_t, uint64_t).
+ */
+template < class E >
+struct t_orbit : public orbit_t
+{
+    public:
+        static_assert( std::is_unsigned< E >::value, "t_orbit requires an unsigned element type" );
+
+        inline void append( const long divisors );
+
+        static constexpr long max_element = std::min< uint64_t >( std::numeric_limits< E >::max(),
+                                                                  ( uint64_t( 1 ) << ( code_bits * max_digits ) ) - 1 );
+};
+
+/**
+ * @brief An orbit of any element width in a tree with an arena can also be released without its destructor
+ */
+template < class E >
+struct t_arena_release< t_orbit< E > > : std::true_type {};
+
+/**
+ * @brief The orbit element type of a path built on integers of type P
+ * @details Fixed width integers can not hold 2^256, so 8-bit elements are enough for every one of them.  See the mpz_class
+ * specialization for multiple precision paths.
+ * @tparam P - The integer type of the path.
+ */
+template < class P >
+struct t_orbit_element
+{
+    typedef uint8_t type;                               /**< The unsigned integer type of an orbit element. */
+};
+
+#ifdef gnu_mp
+/**
+ * @brief Multiple precision paths can start at any 2^k * m, so their orbit elements use the full range of the encoding
+ */
+template <>
+struct t_orbit_element< mpz_class >
+{
+    typedef uint64_t type;                              /**< The unsigned integer type of an orbit element. */
+};
+#endif
+
+
+/**
+ * @brief Compile time Collatz map policy for the connection m * n + a between local termini reduced by factors of the divisor d
+ * @details The constants are returned by constexpr functions, so a path type instantiated with this policy has every % and /
+ * by the divisor folded at compile time.  For the standard 3n+1 map these become masks and shifts, and the checks which hand
+ * positive orbits to the trailing zero count and GMP kernels disappear.
+ * @tparam Mul - The multiplier m of the connection (3).
+ * @tparam Add - The addend a of the connection (1).
+ * @tparam Div - The divisor d factored out of every connection (2).
+ */
+template < int Mul, int Add, int Div >
+struct t_map
+{
+    public:
+        static_assert( Mul > 0 && Div > 1, "t_map requires a positive multiplier and a divisor greater than 1" );
+
+        static constexpr int multiplier() { return Mul; }      /**< Multiplier of the connection. */
+        static constexpr int addend() { return Add; }          /**< Addend of the connection. */
+        static constexpr int divisor() { return Div; }         /**< Divisor factored out of each connection. */
+
+        /** @brief Whether this is the standard 3n+1 map handled by the trailing zero count and GMP kernels */
+        static constexpr bool standard() { return Mul == 3 && Add == 1 && Div == 2; }
+};
+
+/**
+ * @brief The standard 3n+1 Collatz map which all of the path typedefs use
+ */
+typedef t_map< 3, 1, 2 > standard_map;
+
+/**
+ * @brief Run time Collatz map policy which reads the connection constants held in \ref statics
+ * @details This keeps generalized maps such as 5n+1 available without recompiling, at the cost of a real division by the divisor
+ * on every step.  The kernels for the standard map are still used whenever the statics hold the standard constants.
+ */
+struct runtime_map
+{
+    public:
+        static int multiplier() { return statics::multiplier; }    /**< Multiplier of the connection. */
+        static int addend() { return statics::addend; }            /**< Addend of the connection. */
+        static int divisor() { return statics::divisor; }          /**< Divisor factored out of each connection. */
+
+        /** @brief Whether the statics currently hold the standard 3n+1 map */
+        static bool standard() { return statics::divisor == 2 && statics::multiplier == 3 && statics::addend == 1; }
+};
+
+/**
+ * @brief The convergence statistics of a starting integer without its orbit
+ * @details Histogram oriented scans such as the convergent legs and equivalence class counts only consume a few numbers from
+ * each orbit.  The t_path< P >::stats() function computes just these values without recording the orbit, building strings or
+ * looking ahead to the next local terminus, so nothing is allocated for built-in integer types.  Every field matches the
+ * accessor of the same meaning on a path object built from the same starting integer.
+ * @tparam P - The integer type on which the matching path object is based.
+ */
+template < class P >
+struct t_path_stats
+{
+    public:
+        long path_len;                                  /**< The same as pathLength(), the number of downlegs plus one. */
+        long path_factors;                              /**< The same as pathFactors(), the factors of 2 in the orbit. */
+        long class_factors;                             /**< The same as classFactors(), including residual factors of 2. */
+        P max_int;                                      /**< The same as max(), the largest integer in the orbit. */
+        int error_mask;                                 /**< The same as error() for the generic connection. */
+};
 
 /**
  * @brief The templated abstract base class for path objects
@@ -152,14 +308,22 @@ struct orbit_t
  * By specifying mpz_class as the type you get the path variant using GNU multiple precision library for arbitrary large integers.
  * You may choose signed or unsigned integer types.  Signed integers allow you to explore anti-Collatz sequences.
  * @tparam P - The integer type (e.g. ulong, int, int64_t, mpz_class) on which the derived class will be based,
+ * @tparam M - The Collatz map policy, either a compile time \ref t_map (the standard 3n+1 map by default) or \ref runtime_map.
  */
-template < class P >
+template < class P, class M = standard_map >
 class t_path
 {
     public:
+        typedef M map_type;                             /**< The Collatz map policy of this path type. */
+        typedef t_orbit< typename t_orbit_element< P >::type > orbit_type;     /**< The orbit type sized for P. */
+
         /**< Static assertion to ensure the template parameter P is an integral type or mpz_class */
         static_assert(
             std::is_integral<P>::value
+            #ifdef gnu_int128
+            || std::is_same<P, int128_t>::value
+            || std::is_same<P, uint128_t>::value
+            #endif
             #ifdef gnu_mp
             || std::is_same<P, mpz_class>::value
             #endif
@@ -175,11 +339,16 @@ class t_path
         t_path( const std::string &input );             // Equivalence class constructor
         t_path( const char input[] );                   // Equivalence class constructor
 
+        t_path( const t_path< P, M > &rp ) = default;           // Copy constructor copies the state
+        t_path( t_path< P, M > &&rp ) noexcept = default;       // Move constructor
+
         ~t_path();
 
         void setpath( const P &start, int max_factors = 0 );
         inline std::string getpath() const;
 
+        static t_path_stats< P > stats( const P &start );
+
         std::string flow( long digits = -1 ) const;
 
         P ancestry( long &scale ) const;
@@ -187,7 +356,7 @@ class t_path
 
         inline P start() const;
         inline P max() const;
-        inline const orbit_t& orbit();
+        inline const orbit_t& orbit() const;
         inline int sign() const;
         inline int error() const;
 
@@ -197,15 +366,16 @@ class t_path
         inline long classFactors() const;
         inline long nextFactors() const;
 
-        t_path< P > &operator = ( const t_path< P > &rp );
-        t_path< P > &operator = ( const P &rp );                // Why not just assign to a new number?
+        t_path< P, M > &operator = ( const t_path< P, M > &rp ) = default;        // Copies the state without recomputing the orbit
+        t_path< P, M > &operator = ( t_path< P, M > &&rp ) noexcept = default;
+        t_path< P, M > &operator = ( const P &rp );                // Why not just assign to a new number?
 
-        inline bool operator == ( const t_path< P > &rp ) const;
-        inline bool operator != ( const t_path< P > &rp ) const;
-        inline bool operator <  ( const t_path< P > &rp ) const;
-        inline bool operator >  ( const t_path< P > &rp ) const;
-        inline bool operator <= ( const t_path< P > &rp ) const;
-        inline bool operator >= ( const t_path< P > &rp ) const;
+        inline bool operator == ( const t_path< P, M > &rp ) const;
+        inline bool operator != ( const t_path< P, M > &rp ) const;
+        inline bool operator <  ( const t_path< P, M > &rp ) const;
+        inline bool operator >  ( const t_path< P, M > &rp ) const;
+        inline bool operator <= ( const t_path< P, M > &rp ) const;
+        inline bool operator >= ( const t_path< P, M > &rp ) const;
 
         inline void prettyPrint() const;
         inline void prettyPrintClass() const;
@@ -218,22 +388,28 @@ class t_path
         inline void prettyPrintPath( int max_digits ) const;
     
     protected:
-        inline P connection( const P &terminus ) const;
+        static inline P connection( const P &terminus );
         P parse( const std::string &input );
 
         long term( P &i ) const;
-        long factor( P &branch, const P &start );
+        static long factor( P &branch, const P &start );
+        void setpath_ctz( const P &start, int max_factors );
+        static void stats_ctz( const P &start, t_path_stats< P > &s );
+#ifdef gnu_mp
+        void setpath_mpz( const P &start, int max_factors );
+        static void stats_mpz( const P &start, t_path_stats< P > &s );
+#endif
         long set_ec( const P &start );
         long get_ec_len( const std::string &input ) const;
         bool is_signed( const std::string &input ) const;
 
-        void init( P start = 0 );
+        void init( const P &start = 0 );
         void zeroize();
 
         int  int_sign;                                                  /**< Holds the sign of starting integer. */
         P start_int;                                                    /**< Holds the unsigned magnitude of the starting integer. */
         P max_int;                                                      /**< The largest integer magnitude in the convergent orbit. */
-        orbit_t orb;                                                    /**< Holds the complete convergent path. */
+        orbit_type orb;                                                 /**< Holds the complete convergent path. */
 
         int path_factors;                                               /**< The number of divisor factors (2) in the orbit. */
         int ec_factors;                                                 /**< The total number of divisor factors in convergent orbit. */
@@ -244,11 +420,29 @@ class t_path
         collatz_regime regime;                                          /**< The Collatz regime for this path object. */
 };
 
+/**
+ * @brief Hash of a path object for use as a key in hashed containers
+ * @details Path objects are equal exactly when their orbits are, so a path hashes to the fingerprint of its orbit.
+ * @tparam P - The integer data type.
+ * @tparam M - The Collatz map policy.
+ */
+template < class P, class M >
+struct std::hash< t_path< P, M > >
+{
+    inline size_t operator()( const t_path< P, M > &p ) const noexcept;
+};
+
 /**
  * @brief The default path is a signed 64-bit integer
  * @details Other types can be crafted from the t_path<> template, but you need to furnish pathPrint() and to_str() functions
  */
 typedef t_path<int64_t> path;
+typedef t_path_stats<int64_t> path_stats;
+
+/**
+ * @brief The generalized path reads the Collatz map constants from \ref statics at run time
+ */
+typedef t_path<int64_t, runtime_map> general_path;
 
 /**
  * @brief Generic print function which all pretty print variants call
@@ -261,8 +455,9 @@ typedef t_path<int64_t> path;
  * @param [in] flow - The convergence flow whose length is initially set by the starting point and adjusts in the same way was indent does.
  * This std::string parameter is also used for printing out orbital path factors such as "0 1 1 1 3 2" for integer 79.
  * @param [in] max_digits - This is the column width of the first field and derived from the largest integer in the convergent orbit.
+ * @param [in] multiplier - The multiplier of the Collatz map of the path object being printed.
  */
-void pathPrint( const int64_t &start, long length, long factors, int indent, std::string flow, int max_digits );
+void pathPrint( const int64_t &start, long length, long factors, int indent, const char *flow, int max_digits, int multiplier );
 
 /**
  * @brief Return the int64_t integer decimal representation
@@ -276,6 +471,119 @@ void pathPrint( const int64_t &start, long length, long factors, int indent, std
 std::string to_str( const int64_t &remainder );
 
 
+#ifdef gnu_int128
+
+/**
+ * @brief The native 128-bit path template instantiations cover the range between 64-bit and multiple precision integers
+ * @details Orbits which climb past 2^63 no longer need the GNU MP libraries until they climb past 2^127.  The signed variant
+ * keeps the ability to explore anti-Collatz sequences and the unsigned variant doubles the positive range.
+ */
+typedef t_path<int128_t> path128;
+typedef t_path<uint128_t> upath128;
+
+/**
+ * @brief Specialization of the safe_arith struct for the signed native 128-bit integer type
+ * @details The generic overflow checks rely on a division for every multiplication.  The compiler builtins instead read the
+ * overflow flag produced by the operation itself so the checks are nearly free.
+ */
+template <>
+struct safe_arith<int128_t> {
+    static int128_t add(const int128_t& a, const int128_t& b) {
+        int128_t result;
+        if (__builtin_add_overflow(a, b, &result))
+            throw std::overflow_error("Integer addition overflow");
+        return result;
+    }
+
+    static int128_t sub(const int128_t& a, const int128_t& b) {
+        int128_t result;
+        if (__builtin_sub_overflow(a, b, &result))
+            throw std::overflow_error("Integer subtraction overflow");
+        return result;
+    }
+
+    static int128_t mul(const int128_t& a, const int128_t& b) {
+        int128_t result;
+        if (__builtin_mul_overflow(a, b, &result))
+            throw std::overflow_error("Integer multiplication overflow");
+        return result;
+    }
+};
+
+/**
+ * @brief Specialization of the safe_arith struct for the unsigned native 128-bit integer type
+ * @details Identical to the signed specialization, the compiler builtins report any result which wraps around.
+ */
+template <>
+struct safe_arith<uint128_t> {
+    static uint128_t add(const uint128_t& a, const uint128_t& b) {
+        uint128_t result;
+        if (__builtin_add_overflow(a, b, &result))
+            throw std::overflow_error("Integer addition overflow");
+        return result;
+    }
+
+    static uint128_t sub(const uint128_t& a, const uint128_t& b) {
+        uint128_t result;
+        if (__builtin_sub_overflow(a, b, &result))
+            throw std::overflow_error("Integer subtraction overflow");
+        return result;
+    }
+
+    static uint128_t mul(const uint128_t& a, const uint128_t& b) {
+        uint128_t result;
+        if (__builtin_mul_overflow(a, b, &result))
+            throw std::overflow_error("Integer multiplication overflow");
+        return result;
+    }
+};
+
+/**
+ * @brief Native 128-bit print functions which all pretty print int128_t and uint128_t template variants call
+ * @details The standard printf() has no conversion specifier for 128-bit integers, so the starting integer is first converted
+ * with to_str() and then right justified as a string.  Otherwise identical to the int64_t variant.
+ * @param [in] start - The starting integer when the path object was created.
+ * @param [in] length - The number of consecutive Collatz connection path downlegs needed to bring this integer to a smaller value.
+ * @param [in] factors - The length of the equivalence class in the convergent flow - based on the starting integer and decreases.
+ * @param [in] indent - Used to control the indenting of convergence classes - divergence adds 1, convergence decreased by the factors of 2.
+ * @param [in] flow - The convergence flow or the orbital path factors such as "0 1 1 1 3 2" for integer 79.
+ * @param [in] max_digits - This is the column width of the first field and derived from the largest integer in the convergent orbit.
+ * @param [in] multiplier - The multiplier of the Collatz map of the path object being printed.
+ */
+void pathPrint( const int128_t &start, long length, long factors, int indent, const char *flow, int max_digits, int multiplier );
+void pathPrint( const uint128_t &start, long length, long factors, int indent, const char *flow, int max_digits, int multiplier );
+
+/**
+ * @brief Return the native 128-bit integer decimal representation
+ * @details Neither std::to_string() nor printf() support 128-bit integers so the digits are peeled off one at a time.
+ * @param [in] remainder - Const reference to a 128-bit integer.
+ * @return std::string - The decimal string equivalent representation.
+ */
+std::string to_str( const int128_t &remainder );
+std::string to_str( const uint128_t &remainder );
+
+/**
+ * @brief The magnitude of an unsigned 128-bit integer is itself
+ * @details The standard library only provides abs() for signed types and the t_path<> template takes the magnitude of its
+ * integers in a few places.
+ * @param [in] integer - Const reference to an unsigned 128-bit integer.
+ * @return uint128_t - The same integer.
+ */
+inline uint128_t abs( const uint128_t &integer ) { return integer; }
+
+/**
+ * @brief Stream insertion and extraction operators for native 128-bit integers
+ * @details The standard streams do not support 128-bit integers, but the menu templates read and print their integer type
+ * with them.  Extraction accepts an optional sign followed by decimal digits and sets the failbit on overflow.
+ */
+std::ostream &operator << ( std::ostream &os, const int128_t &integer );
+std::ostream &operator << ( std::ostream &os, const uint128_t &integer );
+std::istream &operator >> ( std::istream &is, int128_t &integer );
+std::istream &operator >> ( std::istream &is, uint128_t &integer );
+
+#endif
+
+
 #ifdef gnu_mp
 
 /**
@@ -284,6 +592,8 @@ std::string to_str( const int64_t &remainder );
  * Inclusiong of this variant (and menu options) is controllable via the gnu_mp define.
  */
 typedef t_path<mpz_class> mp_path;
+typedef t_path_stats<mpz_class> mp_path_stats;
+typedef t_path<mpz_class, runtime_map> mp_general_path;
 
 /**
  * @brief Specialization of the safe_arith struct for mpz_class type
@@ -311,8 +621,9 @@ struct safe_arith<mpz_class> {
  * @param [in] flow - The convergence flow whose length is initially set by the starting point and adjusts in the same way was indent does.
  * This std::string parameter is also used for printing out orbital path factors such as "0 1 1 1 3 2" for integer 79.
  * @param [in] max_digits - This is the column width of the first field and derived from the largest integer in the convergent orbit.
+ * @param [in] multiplier - The multiplier of the Collatz map of the path object being printed.
  */
-void pathPrint( const mpz_class &start, long length, long factors, int indent, std::string flow, int max_digits );
+void pathPrint( const mpz_class &start, long length, long factors, int indent, const char *flow, int max_digits, int multiplier );
 
 /**
  * @brief Return the GNU Multiple precision integer decimal representation
@@ -326,6 +637,101 @@ std::string to_str( const mpz_class &remainder );
 
 #endif
 
+#ifdef gnu_mp
+
+/**
+ * @brief Adaptive precision path which begins every orbit with 64-bit integers and promotes only that orbit when needed
+ * @details The scan drivers construct one path object per integer, and nearly all of those orbits fit comfortably within
+ * 64 bits.  Rather than running an entire range with mp_path just to be exact for the few orbits which climb too high, this
+ * class first builds the orbit as a standard path.  If any connection would overflow, the safe_arith<P> checks throw and only
+ * that orbit is rebuilt using the next wider type - path128 where native 128-bit integers are available and then mp_path.
+ * 
+ * The public interface mirrors t_path<> so the class can be handed to the menu templates like any other path type.  Integers
+ * going in and out are mpz_class so that results are exact regardless of which type ended up holding the orbit, although
+ * constructing from a built-in integer skips the conversion entirely.
+ */
+class adaptive_path
+{
+    public:
+        typedef standard_map map_type;                  /**< Every tier uses the standard 3n+1 map. */
+
+        adaptive_path();                                                // Default constructor
+
+        adaptive_path( const int64_t &start );                          // Integer constructor
+        adaptive_path( const int64_t &start, long classLen );           // Integer constructor with class length
+        adaptive_path( const mpz_class &start );                        // Multiple precision integer constructor
+        adaptive_path( const mpz_class &start, long classLen );         // Multiple precision integer constructor with class length
+
+        adaptive_path( const std::string &input );                      // Equivalence class constructor
+        adaptive_path( const char input[] );                            // Equivalence class constructor
+
+        static mp_path_stats stats( const int64_t &start );
+        static mp_path_stats stats( const mpz_class &start );
+
+        inline std::string getpath() const;
+        std::string flow( long digits = -1 ) const;
+
+        mpz_class ancestry( long &scale ) const;
+        mpz_class next() const;
+
+        mpz_class start() const;
+        mpz_class max() const;
+        inline const orbit_t& orbit() const;
+        inline int sign() const;
+        inline int error() const;
+        inline int precision() const;
+
+        inline long pathLength() const;
+        inline long classLength() const;
+        inline long pathFactors() const;
+        inline long classFactors() const;
+        inline long nextFactors() const;
+
+        inline bool operator == ( const adaptive_path &rp ) const;
+        inline bool operator != ( const adaptive_path &rp ) const;
+        inline bool operator <  ( const adaptive_path &rp ) const;
+        inline bool operator >  ( const adaptive_path &rp ) const;
+        inline bool operator <= ( const adaptive_path &rp ) const;
+        inline bool operator >= ( const adaptive_path &rp ) const;
+
+        inline void prettyPrint() const;
+        inline void prettyPrintClass() const;
+        inline void prettyPrintPath() const;
+
+        inline void prettyPrint( int max_digits ) const;
+        inline void prettyPrint( long len, int max_digits ) const;
+        inline void prettyPrint( long len, long indent, int max_digits ) const;
+        inline void prettyPrintClass( int max_digits ) const;
+        inline void prettyPrintPath( int max_digits ) const;
+
+    protected:
+        template < class Q, class I > bool attempt( const I &start, bool classed, long class_len );
+        template < class Q > bool attempt( const std::string &input );
+        template < class Q, class I > static bool attempt_stats( const I &start, mp_path_stats &s );
+
+        void build( const int64_t &start, bool classed, long class_len );
+        void build( const mpz_class &start, bool classed, long class_len );
+        void build( const std::string &input );
+
+        /**< The narrowest path type which was able to represent the complete orbit. */
+        std::variant< path,
+#ifdef gnu_int128
+                      path128,
+#endif
+                      mp_path > tier;
+};
+
+/**
+ * @brief Hash of an adaptive_path, which is the fingerprint of its orbit whatever the precision it was built with
+ */
+template <>
+struct std::hash< adaptive_path >
+{
+    inline size_t operator()( const adaptive_path &p ) const noexcept;
+};
+
+#endif
+
 // Maybe inheritence is overkill - all you really need is local constant in the object to change the behavior?
 // Negative Collatz with "corrected" constants
 class antipath : public path
@@ -0,0 +1,130 @@
+/**
+ * @file sieve.cpp
+ * @author Wayne Brassem (wbrassem@rogers.com)
+ * @brief Implementation of the residue sieve used by the scan drivers to skip integers whose convergent orbit is already known.
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023-2026 Wayne Brassem
+ */
+
+#include <algorithm>
+#include <memory>
+#include "common.hpp"
+#include "sieve.hpp"
+
+/**
+ * @brief Construct the residue sieve modulo 3 * 2^k
+ * @details Each residue r modulo 2^k is run forward up to k Terras steps while tracking the affine map
+ * T^j(n) = ( 3^c * n + a ) / 2^j.  The first step with 3^c < 2^j sieves the residue, and any integer n with
+ * n * ( 2^j - 3^c ) <= a does not drop below itself at that step, so the largest such n is the threshold for the residue.
+ * Residues which never get there within k steps survive.  The residues modulo 3 * 2^k inherit the outcome of their residue
+ * modulo 2^k.
+ * @param [in] k - Number of residue bits, which must be between min_bits and max_bits.
+ */
+residue_sieve::residue_sieve( int k )
+{
+    const long power = 1L << k;
+    std::vector< bool > survives( power, true );
+    uint64_t threshold = 0;
+
+    mod = 3 * power;
+
+    for ( long residue = 0; residue < power; residue++ )
+    {
+        uint64_t t = residue, pow3 = 1, addend = 0;
+
+        // The parity after j steps depends on the residue modulo 2^(j+1), so k steps are certain
+        for ( int j = 1; j <= k; j++ )
+        {
+            if ( t & 1 )
+            {
+                addend = 3 * addend + ( uint64_t( 1 ) << ( j - 1 ) );
+                pow3 *= 3;
+                t = ( 3 * t + 1 ) >> 1;
+            }
+            else
+                t >>= 1;
+
+            // The coefficient has dropped below one so every large enough integer has converged
+            if ( pow3 < ( uint64_t( 1 ) << j ) )
+            {
+                survives[ residue ] = false;
+                threshold = std::max( threshold, addend / ( ( uint64_t( 1 ) << j ) - pow3 ) );
+                break;
+            }
+        }
+    }
+
+    for ( long residue = 0; residue < mod; residue++ )
+    {
+        if ( survives[ residue % power ] )
+            survivor_list.push_back( residue );
+        else
+            sieved_list.push_back( residue );
+    }
+
+    // Scan at least the first full block so that the smallest integers are always examined directly
+    scan_floor = mod * ( threshold / mod + 1 );
+}
+
+/**
+ * @brief Return the cached residue sieve for 3 * 2^k residues, building it on first use
+ * @param [in] k - Number of residue bits.  Zero or any value outside min_bits to max_bits means the sieve is disabled.
+ * @return const residue_sieve* - Pointer to the sieve or nullptr if the sieve is disabled.
+ */
+const residue_sieve *residue_sieve::select( int k )
+{
+    static std::unique_ptr< residue_sieve > sieves[ max_bits + 1 ];
+
+    if ( k < min_bits || k > max_bits )
+        return nullptr;
+
+    if ( !sieves[ k ] )
+        sieves[ k ] = std::make_unique< residue_sieve >( k );
+
+    return sieves[ k ].get();
+}
+
+/**
+ * @brief Return the next integer which needs to be scanned
+ * @details Below the floor that is simply the next integer, above it the next integer belonging to a surviving residue.
+ * @param [in] i - The integer just scanned.
+ * @return long - The next integer to scan.
+ */
+long residue_sieve::next( long i ) const
+{
+    if ( i + 1 <= scan_floor )
+        return i + 1;
+
+    long residue = i % mod;
+    auto it = std::upper_bound( survivor_list.begin(), survivor_list.end(), residue );
+
+    if ( it == survivor_list.end() )
+        return i - residue + mod + survivor_list.front();
+
+    return i - residue + *it;
+}
+
+/**
+ * @brief Return the number of integers in each sieved residue between the floor and the end of the range
+ * @param [in] range - The upper limit of the range, which must be a multiple of the modulus.
+ * @return long - The number of integers of each sieved residue above the floor, or zero if the range ends below the floor.
+ */
+long residue_sieve::members( long range ) const
+{
+    return ( range > scan_floor ) ? ( range - scan_floor ) / mod : 0;
+}
+
+/**
+ * @brief Return the largest integer belonging to a residue which is no greater than the end of the range
+ * @details Since the orbits of all the integers in a sieved residue above the floor are the same, any of them can stand in for
+ * the rest.  The largest is used so that it also carries the largest maximum integer of its residue in the range.
+ * @param [in] residue - The residue modulo 3 * 2^k.
+ * @param [in] range - The upper limit of the range, which must be a multiple of the modulus.
+ * @return long - The largest integer congruent to the residue which is no greater than range.
+ */
+long residue_sieve::largest( long residue, long range ) const
+{
+    return range - ( mod - residue ) % mod;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file sieve.hpp
+ * @author Wayne Brassem (wbrassem@rogers.com)
+ * @brief The residue_sieve class finds the residues modulo 3 * 2^k whose convergent orbit is fixed by the residue alone so that
+ * the scan drivers only need to examine the remaining residues one integer at a time
+ * @version 1.0
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2023-2026 Wayne Brassem
+ *
+ */
+
+#pragma once
+#include "common.hpp"
+
+/**
+ * @brief The residue_sieve class splits the residues modulo 3 * 2^k into those which are sieved and those which survive
+ * @details Every integer congruent to r modulo 2^k has the same parity sequence for its first k Terras steps, where the Terras
+ * map T(n) takes n to n/2 if n is even and to (3n+1)/2 if n is odd.  If that sequence holds c odd integers among the first
+ * j <= k steps then T^j(n) = ( 3^c * n + a ) / 2^j.  The first j with 3^c < 2^j is the stopping time of every integer in the
+ * residue class above a / ( 2^j - 3^c ), since the orbit stays above the start until then.  All of those integers share the same
+ * convergent orbit, so a single path object stands in for all of them.
+ *
+ * The scan drivers work over ranges of 3 * 2^e integers and classify orbits by their equivalence class as well, which depends on
+ * the integer modulo 3 * 2^j.  So the sieve works modulo 3 * 2^k, and every integer up to a floor above all the thresholds is
+ * scanned regardless.  Sieves are built on demand by select() and kept for the life of the program.
+ */
+class residue_sieve
+{
+    public:
+        residue_sieve( int k );                         // Build the sieve for residues modulo 3 * 2^k
+
+        static const residue_sieve *select( int k );    // Cached sieve for 3 * 2^k residues or nullptr if k is zero
+
+        long next( long i ) const;                      // Next integer after i which needs to be scanned
+        long members( long range ) const;               // Number of integers in each sieved residue above the floor
+        long largest( long residue, long range ) const; // Largest integer of a residue in the range
+
+        inline long modulus() const;
+        inline long floor() const;
+        inline const std::vector< long > &survivors() const;
+        inline const std::vector< long > &sieved() const;
+
+        static const int min_bits = 2;                  /**< Smallest supported number of residue bits. */
+        static const int max_bits = 20;                 /**< Largest supported number of residue bits. */
+
+    protected:
+        long mod;                                       /**< The modulus 3 * 2^k. */
+        long scan_floor;                                /**< Every integer up to this multiple of the modulus is scanned. */
+
+        std::vector< long > survivor_list;              /**< Ascending residues which must be scanned one integer at a time. */
+        std::vector< long > sieved_list;                /**< Ascending residues whose orbit is fixed above the floor. */
+};
+
+/**
+ * @brief Return the modulus of the sieve
+ * @return long - Returns 3 * 2^k.
+ */
+long residue_sieve::modulus() const
+{
+    return mod;
+}
+
+/**
+ * @brief Return the floor up to which every integer is scanned
+ * @return long - A multiple of the modulus greater than every threshold.
+ */
+long residue_sieve::floor() const
+{
+    return scan_floor;
+}
+
+/**
+ * @brief Return the residues which must be scanned one integer at a time
+ * @return const std::vector< long >& - Ascending residues modulo 3 * 2^k.
+ */
+const std::vector< long > &residue_sieve::survivors() const
+{
+    return survivor_list;
+}
+
+/**
+ * @brief Return the residues whose convergent orbit is fixed by the residue above the floor
+ * @return const std::vector< long >& - Ascending residues modulo 3 * 2^k.
+ */
+const std::vector< long > &residue_sieve::sieved() const
+{
+    return sieved_list;
+}